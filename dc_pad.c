@@ -28,13 +28,20 @@
 #include "dc_pad.h"
 #include "maplebus.h"
 
-#define MOUSE_REPORT_SIZE		5
+#define MOUSE_REPORT_SIZE		6
 #define CONTROLLER_REPORT_SIZE	6
-#define KEYBOARD_REPORT_SIZE	7
+#define KEYBOARD_REPORT_SIZE	8
 #define MAX_REPORT_SIZE			8
 
 
-#define NUM_REPORTS				1
+// One report per port. With more than one port, each port is a gamepad
+// and its reports start with the report ID (port number + 1).
+#define NUM_REPORTS				MAPLE_NUM_PORTS
+#if NUM_REPORTS > 1
+#define REPORT_ID_SIZE			1
+#else
+#define REPORT_ID_SIZE			0
+#endif
 
 // report matching the most recent bytes from the controller
 static unsigned char last_built_report[NUM_REPORTS][MAX_REPORT_SIZE];
@@ -42,7 +49,67 @@ static unsigned char last_built_report[NUM_REPORTS][MAX_REPORT_SIZE];
 // the most recently reported bytes
 static unsigned char last_sent_report[NUM_REPORTS][MAX_REPORT_SIZE];
 
-static unsigned char cur_report_size = CONTROLLER_REPORT_SIZE;
+// Once a device answers, the time allowed for its replies to start
+// shrinks to what it needs plus a margin. It goes back to the default
+// when a reply is missed or a different device is connected.
+#define START_TIMEOUT_MARGIN_US	50
+
+typedef struct {
+	unsigned char state;
+	unsigned char err_count;
+	unsigned char probe_delay; // polls until the next probe of an empty port
+	uint8_t addr; // MAPLE_ADDR_PORTx
+
+	uint16_t connected_device;
+
+	// set when last_built_report was rebuilt since dcChanged() last looked
+	char report_dirty;
+
+	// condition bytes (8 to 15) from the previous reply
+	unsigned char last_condition[8];
+	char last_condition_valid;
+
+	unsigned int start_timeout;
+	LatencyStats latency;
+	uint32_t latency_sum;
+
+	// GET_CONDITION frame for the connected device, built once
+	unsigned char condition_frame[MAPLE_FRAME1W_SIZE];
+
+	unsigned char func_data[4];
+	uint8_t subs; // MAPLE_ADDR_SUB() bits from the last reply
+	uint8_t lcd_addr;
+	int lcd_detect_count;
+	uint8_t rumble_addr; // purupuru pack, 0 if none
+
+	// magnitude from the host (output report), and how many more
+	// times the rumble pack may be told (see SET_CONDITION_TRIES)
+	unsigned char rumble;
+	unsigned char rumble_pending;
+
+	// mouse motion not sent to the host yet
+	int16_t motion_x, motion_y, motion_w;
+} DcPort;
+
+static DcPort ports[MAPLE_NUM_PORTS];
+
+// Keyboard reports not sent yet, oldest first, so that keys pressed and
+// released between two reads by the host are not lost. Keyboards are
+// only supported with a single port.
+#define KEYBOARD_QUEUE_SIZE		4
+static unsigned char kbd_queue[KEYBOARD_QUEUE_SIZE][KEYBOARD_REPORT_SIZE];
+static unsigned char kbd_queue_head, kbd_queue_len;
+
+// A SET_CONDITION command which is not acknowledged is sent again at
+// the next poll, this many times in all. A device may not support it.
+#define SET_CONDITION_TRIES		3
+
+// LED state from the host (output report), and how many more times the
+// keyboard may be told (0 once it acknowledged).
+static unsigned char kbd_leds;
+static unsigned char kbd_leds_pending;
+
+static unsigned char cur_report_size = REPORT_ID_SIZE + CONTROLLER_REPORT_SIZE;
 
 static Gamepad dcGamepad;
 
@@ -55,40 +122,73 @@ static void dcUpdate(void);
  * [3] Rtrig
  * [4] Btn 0-7
  * [5] Btn 8-15 
+ *
+ * Output report:
+ * [0] Rumble magnitude (0 stops)
  */
+#define PAD_REPORT_ITEMS \
+	0x09, 0x01,                    /*   USAGE (Pointer) */ \
+	0xa1, 0x00,                    /*   COLLECTION (Physical) */ \
+    0x09, 0x30,                    /*     USAGE (X) */ \
+    0x09, 0x31,                    /*     USAGE (Y) */ \
+	0x09, 0x36,					   /*	  USAGE (Slider) */ \
+	0x09, 0x36, \
+    0x15, 0x00,                    /*   LOGICAL_MINIMUM (0) */ \
+    0x26, 0xff, 0x00,              /*     LOGICAL_MAXIMUM (255) */ \
+    0x75, 0x08,                    /*   REPORT_SIZE (8) */ \
+    0x95, 0x04,                    /*   REPORT_COUNT (4) */ \
+    0x81, 0x02,                    /*   INPUT (Data,Var,Abs) */ \
+	0x05, 0x09,                    /* USAGE_PAGE (Button) */ \
+    0x19, 0x01,                    /*   USAGE_MINIMUM (Button 1) */ \
+    0x29, 0x10,                    /*   USAGE_MAXIMUM (Button 16) */ \
+    0x15, 0x00,                    /*   LOGICAL_MINIMUM (0) */ \
+    0x25, 0x01,                    /*   LOGICAL_MAXIMUM (1) */ \
+    0x75, 0x01,                    /* REPORT_SIZE (1) */ \
+    0x95, 0x10,                    /* REPORT_COUNT (16) */ \
+    0x81, 0x02,                    /* INPUT (Data,Var,Abs) */ \
+    0xc0,                          /* END_COLLECTION */ \
+	0x05, 0x0f,                    /* USAGE_PAGE (Physical Interface) */ \
+	0x09, 0x70,                    /* USAGE (Magnitude) */ \
+    0x15, 0x00,                    /* LOGICAL_MINIMUM (0) */ \
+    0x26, 0xff, 0x00,              /* LOGICAL_MAXIMUM (255) */ \
+    0x75, 0x08,                    /* REPORT_SIZE (8) */ \
+    0x95, 0x01,                    /* REPORT_COUNT (1) */ \
+    0x91, 0x02                     /* OUTPUT (Data,Var,Abs) */
+
 static const unsigned char dcPadReport[] PROGMEM = {
     0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
     0x09, 0x05,                    // USAGE (Game pad)
     0xa1, 0x01,                    // COLLECTION (Application)
-	0x09, 0x01,                    //   USAGE (Pointer)    
-	0xa1, 0x00,                    //   COLLECTION (Physical)
-    0x09, 0x30,                    //     USAGE (X)
-    0x09, 0x31,                    //     USAGE (Y)
-	0x09, 0x36,					   //	  USAGE (Slider)
-	0x09, 0x36,
-    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
-    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
-    0x75, 0x08,                    //   REPORT_SIZE (8)
-    0x95, 0x04,                    //   REPORT_COUNT (4)
-    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
-	0x05, 0x09,                    // USAGE_PAGE (Button)
-    0x19, 0x01,                    //   USAGE_MINIMUM (Button 1)
-    0x29, 0x10,                    //   USAGE_MAXIMUM (Button 16)
-    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
-    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
-    0x75, 0x01,                    // REPORT_SIZE (1)
-    0x95, 0x10,                    // REPORT_COUNT (16)
-    0x81, 0x02,                    // INPUT (Data,Var,Abs)
-    0xc0,                          // END_COLLECTION
+	PAD_REPORT_ITEMS,
     0xc0,                          // END_COLLECTION
 };
 
+#if MAPLE_NUM_PORTS > 1
+/* One gamepad per port, the same report prefixed by the report ID. */
+#define PAD_COLLECTION(id) \
+    0x05, 0x01,                    /* USAGE_PAGE (Generic Desktop) */ \
+    0x09, 0x05,                    /* USAGE (Game pad) */ \
+    0xa1, 0x01,                    /* COLLECTION (Application) */ \
+	0x85, (id),                    /*   REPORT_ID (id) */ \
+	PAD_REPORT_ITEMS, \
+    0xc0                           /* END_COLLECTION */
+
+static const unsigned char dcMultiPadReport[] PROGMEM = {
+	PAD_COLLECTION(1),
+	PAD_COLLECTION(2),
+#if MAPLE_NUM_PORTS > 2
+	PAD_COLLECTION(3),
+#endif
+};
+#endif
+
 /*
  * [0] Mouse buttons
  * [1] Mouse X
  * [2] Mouse X
  * [3] Mouse Y
  * [4] Mouse Y
+ * [5] Mouse wheel
  */
 static const unsigned char dcMouseReport[] PROGMEM = {
 	0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
@@ -115,6 +215,12 @@ static const unsigned char dcMouseReport[] PROGMEM = {
     0x75, 0x10,                    //     REPORT_SIZE (16)
     0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x06,                    //     INPUT (Data,Var,Rel)
+    0x09, 0x38,                    //     USAGE (Wheel)
+    0x15, 0x81,                    //     LOGICAL_MINIMUM (-127)
+    0x25, 0x7f,                    //     LOGICAL_MAXIMUM (127)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x06,                    //     INPUT (Data,Var,Rel)
     0xc0,                          //   END_COLLECTION
     0xc0,                          // END_COLLECTION
 };
@@ -149,8 +255,9 @@ static const unsigned char dcKeyboardReport[] PROGMEM = {
 		0x81, 0x02, // Input (Data, Variable, Absolute)
 
 			// Reserved Byte
-//		0x95, 0x01, // Report Count(1)
-//		0x75, 0x08, // Report Size(8)
+		0x95, 0x01, // Report Count(1)
+		0x75, 0x08, // Report Size(8)
+		0x81, 0x03, // Input (Constant)
 
 		0x95, 0x06, // Report Count(6)
 		0x75, 0x08, // Report Size(8)
@@ -163,6 +270,18 @@ static const unsigned char dcKeyboardReport[] PROGMEM = {
 		0x29, 0xFF, // Usage Maximum(255)
 		0x81, 0x00, // Input (Data, Array)
 
+			// LEDs (output)
+		0x05, 0x08, // Usage Page (LEDs)
+		0x19, 0x01, // Usage Minimum (Num Lock)
+		0x29, 0x05, // Usage Maximum (Kana)
+		0x25, 0x01, // Logical Maximum (1)
+		0x95, 0x05, // Report Count(5)
+		0x75, 0x01, // Report Size(1)
+		0x91, 0x02, // Output (Data, Variable, Absolute)
+		0x95, 0x01, // Report Count(1)
+		0x75, 0x03, // Report Size(3)
+		0x91, 0x03, // Output (Constant)
+
     0xc0,                          // END_COLLECTION
 };
 
@@ -220,25 +339,42 @@ const unsigned char dcKeyboardDevDesc[] PROGMEM = {    /* USB device descriptor
 
 #define DEFAULT_FUNCTION	MAPLE_FUNC_CONTROLLER
 
-static uint16_t cur_connected_device = DEFAULT_FUNCTION;
-
 /* Used to report the change of function to the main loop
- * which will then re-init. */
+ * which will then re-init. With more than one port, the
+ * descriptors never change. */
 static char dcDescriptorsChanged(void)
 {
 	static uint16_t previous_function = DEFAULT_FUNCTION;
 
-	if (cur_connected_device != previous_function) {
-		previous_function = cur_connected_device;
+	if (ports[0].connected_device != previous_function) {
+		previous_function = ports[0].connected_device;
 		return 1;
 	}
 	return 0;
 }
 
-static void setConnectedDevice(uint16_t func)
+static void setConnectedDevice(DcPort *port, uint16_t func)
 {
-	cur_connected_device = func;
-
+	port->connected_device = func;
+	port->last_condition_valid = 0;
+	port->start_timeout = MAPLE_START_TIMEOUT_US;
+	memset(&port->latency, 0, sizeof(port->latency));
+	port->latency.func = func;
+	port->latency_sum = 0;
+	port->subs = 0;
+	port->lcd_addr = 0;
+	port->rumble_addr = 0;
+	port->rumble_pending = 0;
+	port->motion_x = port->motion_y = port->motion_w = 0;
+	kbd_queue_len = 0;
+	kbd_leds_pending = SET_CONDITION_TRIES; // a new keyboard gets the current state
+
+	maple_buildFrame1W(port->condition_frame, MAPLE_CMD_GET_CONDITION,
+						port->addr | MAPLE_ADDR_MAIN,
+						MAPLE_DC_ADDR | port->addr,
+						func);
+
+#if MAPLE_NUM_PORTS == 1
 	switch (func)
 	{
 		case MAPLE_FUNC_CONTROLLER:
@@ -265,32 +401,66 @@ static void setConnectedDevice(uint16_t func)
 			cur_report_size = KEYBOARD_REPORT_SIZE;
 			break;
 	}
+#endif
 }
 
 
 
 static void dcInit(void)
 {
-	setConnectedDevice(DEFAULT_FUNCTION);
+	unsigned char p, i;
+
+	maple_init();
+
+	for (p=0; p<MAPLE_NUM_PORTS; p++) {
+		// The first port keeps the address single port adapters used
+		ports[p].addr = MAPLE_ADDR_PORT((p + 1) & 3);
+		setConnectedDevice(&ports[p], DEFAULT_FUNCTION);
+#if MAPLE_NUM_PORTS > 1
+		last_built_report[p][0] = p + 1;
+#endif
+	}
+
+#if MAPLE_NUM_PORTS > 1
+	dcGamepad.reportDescriptor = (void*)dcMultiPadReport;
+	dcGamepad.reportDescriptorSize = sizeof(dcMultiPadReport);
+	dcGamepad.deviceDescriptor = (void*)dcPadDevDesc;
+	dcGamepad.deviceDescriptorSize = sizeof(dcPadDevDesc);
+#endif
 
 	/* Try to detect the exact peripheral before continuing. The allows
-	 * the adapter to enumerate as the correct device right away. */
-	dcUpdate();
-	dcUpdate();
-	dcUpdate();
+	 * the adapter to enumerate as the correct device right away. A
+	 * device slow to answer after power up gets every probe: the
+	 * interval between probes of empty ports only starts afterwards. */
+	for (i=0; i<3; i++) {
+		dcUpdate();
+		for (p=0; p<MAPLE_NUM_PORTS; p++) {
+			ports[p].probe_delay = 0;
+		}
+	}
 }
 
 #define MAX_ERRORS 100
 
+// Pause in the middle of mouse replies, added to the receive deadline.
+// Not measured: a generous guess. It only delays polls which fail, a
+// complete reply ends the reception.
+#define MOUSE_REPLY_PAUSE_US	1000
+
+// Limits of the accumulated mouse motion (see dcMouseReport)
+#define MOUSE_MAX_XY	511
+#define MOUSE_MAX_WHEEL	127
+
+// Polls skipped between RQ_DEV_INFO probes of an empty port (about
+// 50ms). Only a probe that gets no reply at all is delayed.
+#define EMPTY_PORT_PROBE_INTERVAL	16
+
 #define STATE_RESET_DEVICE		0
 #define STATE_GET_INFO			1
 #define STATE_READ_PAD			2
 #define STATE_READ_MOUSE		3
 #define STATE_READ_KEYBOARD		4
-#define STATE_LCD_DETECT		5
-#define STATE_BANNER_DISPLAY	6
 #define STATE_NULL				7
-static unsigned char state = STATE_RESET_DEVICE;
 
 const char lcd_data_raphnet[200] PROGMEM = {
 	0x00, 0x00, 0x00, 0x04,
@@ -305,52 +475,286 @@ const char lcd_data_image[200] PROGMEM = {
 };
 
 
-static uint8_t lcd_addr = 0;
-
-static void updateLcd(char id)
+static void updateLcd(DcPort *port, char id)
 {
-	unsigned char tmp[30];
+	unsigned char tmp[8]; // ACK expected
 
-	if (lcd_addr) {
+	if (port->lcd_addr) {
 		maple_sendFrame_P(MAPLE_CMD_BLOCK_WRITE,
-					lcd_addr,
-					MAPLE_DC_ADDR | MAPLE_ADDR_PORTB,
+					port->lcd_addr,
+					MAPLE_DC_ADDR | port->addr,
 					200, id ? lcd_data_image : lcd_data_raphnet);
-		maple_receiveFrame(tmp, 30);
+		maple_receiveFrame(tmp, sizeof(tmp));
 	}
 }
 
-static void pollSubs(void)
+/* Idle controllers and keyboards send the same condition at each poll.
+ * Remember the condition bytes to skip building a report when they
+ * did not change.
+ *
+ * \param condition Bytes 8 to 15 of the GET_CONDITION reply
+ * \return True if identical to the previous call
+ */
+static char conditionUnchanged(DcPort *port, const unsigned char *condition)
 {
-	int i, v;
-	unsigned char tmp[30];
+	if (port->last_condition_valid &&
+			!memcmp(port->last_condition, condition, sizeof(port->last_condition)))
+		return 1;
+
+	memcpy(port->last_condition, condition, sizeof(port->last_condition));
+	port->last_condition_valid = 1;
+
+	return 0;
+}
+
+static void recordLatency(DcPort *port, unsigned int us)
+{
+	LatencyStats *latency = &port->latency;
+
+	if (!latency->count || us < latency->min_us)
+		latency->min_us = us;
+	if (us > latency->max_us)
+		latency->max_us = us;
+	latency->last_us = us;
+
+	// Keep the mean running by halving the history when full
+	if (latency->count == 0xffff) {
+		latency->count /= 2;
+		port->latency_sum /= 2;
+	}
+	latency->count++;
+	port->latency_sum += us;
+}
+
+void dcGetLatencyStats(LatencyStats *dst, unsigned char port_id)
+{
+	DcPort *port;
+
+	if (port_id >= MAPLE_NUM_PORTS)
+		port_id = 0;
+	port = &ports[port_id];
+
+	memcpy(dst, &port->latency, sizeof(LatencyStats));
+	if (port->latency.count) {
+		dst->mean_us = port->latency_sum / port->latency.count;
+	}
+	dst->start_timeout_us = port->start_timeout;
+}
+
+/* Record the latency and adjust the start timeout after polling
+ * the connected device.
+ *
+ * \param v The value returned by maple_receiveFrame()
+ */
+static void adaptStartTimeout(DcPort *port, int v)
+{
+	unsigned int needed;
+
+	if (v == -1) {
+		port->latency.timeouts++;
+		port->start_timeout = MAPLE_START_TIMEOUT_US;
+	} else {
+		recordLatency(port, maple_getLatency());
+
+		// Based on the slowest reply seen, not the last one, so that a
+		// fast reply does not leave too little time for the next ones.
+		needed = port->latency.max_us;
+		needed += needed / 2 + START_TIMEOUT_MARGIN_US;
+		if (needed > MAPLE_START_TIMEOUT_US) {
+			needed = MAPLE_START_TIMEOUT_US;
+		}
+		port->start_timeout = needed;
+	}
+
+	maple_setStartTimeout(port->start_timeout);
+}
+
+// Polls from the detection of an LCD to the first image, and to the second.
+// Sending the image right away after detection does not seem to work.
+#define LCD_IMAGE_DELAY			220
+#define LCD_BANNER_DELAY		(LCD_IMAGE_DELAY + 400)
+
+/* Ask the sub-peripheral in slot i what it is.
+ *
+ * \return 1 if it replied, 0 otherwise
+ */
+static char querySub(DcPort *port, int i)
+{
+	int v;
+	// Called from dcReadPad() while its own reply buffer is in use, keep
+	// the stack small: only the first word (functions) is needed, the
+	// rest of the reply is dropped (-3).
+	unsigned char tmp[12];
+	char found = 0;
+
+	maple_setStartTimeout(MAPLE_START_TIMEOUT_US);
+	maple_sendFrame(MAPLE_CMD_RQ_DEV_INFO,
+					MAPLE_ADDR_SUB(i) | port->addr,
+					MAPLE_DC_ADDR | port->addr,
+					0, NULL);
+	v =  maple_receiveFrame(tmp, sizeof(tmp));
+	if (v==-2 || v==-3) {
+		_delay_ms(2);
+		uint16_t func = tmp[7] | tmp[6]<<8;
+
+		if (func & MAPLE_FUNC_LCD) {
+			port->lcd_addr = MAPLE_ADDR_SUB(i) | port->addr;
+			port->lcd_detect_count = 0;
+		}
+		if (func & MAPLE_FUNC_PURUPURU) {
+			port->rumble_addr = MAPLE_ADDR_SUB(i) | port->addr;
+			port->rumble_pending = port->rumble ? SET_CONDITION_TRIES : 0;
+		}
+		found = 1;
+	}
+	maple_setStartTimeout(port->start_timeout);
+
+	return found;
+}
+
+/* The source address of replies from the main peripheral has a bit set
+ * for each sub-peripheral attached (VMU, rumble pack...). Only the slots
+ * which just appeared are asked what they are. A slot which did not
+ * reply is asked again at the next poll.
+ *
+ * \param subs The MAPLE_ADDR_SUB() bits from the last reply
+ */
+static void updateSubs(DcPort *port, uint8_t subs)
+{
+	uint8_t added = subs & ~port->subs;
+	int i;
+
+	// Forget the slots which were emptied
+	port->subs &= subs;
+
+	if (!(port->lcd_addr & subs)) {
+		port->lcd_addr = 0;
+	}
+	if (!(port->rumble_addr & subs)) {
+		port->rumble_addr = 0;
+	}
 
 	for (i=0; i<5; i++) {
-		maple_sendFrame(MAPLE_CMD_RQ_DEV_INFO,
-						MAPLE_ADDR_SUB(i) | MAPLE_ADDR_PORTB,
-						MAPLE_DC_ADDR | MAPLE_ADDR_PORTB,
-						0, NULL);
-		v =  maple_receiveFrame(tmp, 30);
-		if (v==-2) {
-			_delay_ms(2);
-			uint16_t func = tmp[4] | tmp[5]<<8;
-
-			if (func & MAPLE_FUNC_LCD) {
-				lcd_addr = MAPLE_ADDR_SUB(i) | MAPLE_ADDR_PORTB;
-			}
+		if ((added & MAPLE_ADDR_SUB(i)) && querySub(port, i)) {
+			port->subs |= MAPLE_ADDR_SUB(i);
+		}
+	}
+
+	// Show the images once the LCD had time to settle
+	if (port->lcd_addr && port->lcd_detect_count <= LCD_BANNER_DELAY) {
+		if (port->lcd_detect_count == LCD_IMAGE_DELAY) {
+			updateLcd(port, 0);
+		} else if (port->lcd_detect_count == LCD_BANNER_DELAY) {
+			updateLcd(port, 1);
 		}
+		port->lcd_detect_count++;
 	}
 }
 
-static void dcReadPad(void)
+/* Send the rumble magnitude from the host to the purupuru pack.
+ *
+ * 0 stops the motor, otherwise it runs at one of the 7 intensities. As
+ * the console lays it out, the effect word is special (bit 4 selects the
+ * motor), effect 1 (intensity in bits 4-6), effect 2 and duration. Each
+ * word goes on the bus byte-reversed, so they are data[7] down to data[4].
+ */
+static void setRumble(DcPort *port)
+{
+	unsigned char tmp[8]; // ACK expected
+	unsigned char data[8] = { // bus order
+		MAPLE_FUNC_PURUPURU & 0xff, MAPLE_FUNC_PURUPURU >> 8, 0, 0,
+		0, 0, 0, 0,
+	};
+	int v;
+
+	if (!port->rumble_addr) {
+		port->rumble_pending = 0;
+		return;
+	}
+	port->rumble_pending--;
+
+	if (port->rumble) {
+		data[6] = (1 + port->rumble * 6 / 255) << 4;
+		data[7] = 0x10;
+	}
+
+	maple_setStartTimeout(MAPLE_START_TIMEOUT_US);
+	maple_sendFrame(MAPLE_CMD_SET_CONDITION,
+					port->rumble_addr,
+					MAPLE_DC_ADDR | port->addr,
+					sizeof(data), data);
+	v = maple_receiveFrame(tmp, sizeof(tmp));
+	maple_setStartTimeout(port->start_timeout);
+
+	// Otherwise, try again at the next update if tries are left
+	if (v >= 4 && tmp[0] == MAPLE_RESP_ACK) {
+		port->rumble_pending = 0;
+	}
+}
+
+/* Send the LED state from the host to the keyboard.
+ *
+ * The USB LED bits (Num, Caps, Scroll, Compose, Kana) match the LED byte
+ * of the keyboard condition (byte 9 of the GET_CONDITION reply), and
+ * SET_CONDITION takes it at the same place.
+ */
+static void setKeyboardLeds(DcPort *port)
+{
+	unsigned char tmp[8]; // ACK expected
+	unsigned char data[8] = { // bus order
+		MAPLE_FUNC_KEYBOARD, 0, 0, 0,
+		0, 0, kbd_leds, 0,
+	};
+	int v;
+
+	kbd_leds_pending--;
+
+	// The timeout adapted to GET_CONDITION replies may be too short
+	maple_setStartTimeout(MAPLE_START_TIMEOUT_US);
+	maple_sendFrame(MAPLE_CMD_SET_CONDITION,
+					port->addr | MAPLE_ADDR_MAIN,
+					MAPLE_DC_ADDR | port->addr,
+					sizeof(data), data);
+	v = maple_receiveFrame(tmp, sizeof(tmp));
+	maple_setStartTimeout(port->start_timeout);
+
+	// Otherwise, try again at the next poll if tries are left
+	if (v >= 4 && tmp[0] == MAPLE_RESP_ACK) {
+		kbd_leds_pending = 0;
+	}
+}
+
+static void queueKeyboardReport(const unsigned char *report)
+{
+	unsigned char i;
+
+	if (kbd_queue_len == KEYBOARD_QUEUE_SIZE) {
+		// Full. Replace the newest report so the last state still gets
+		// through, only an intermediate one is lost.
+		i = (kbd_queue_head + kbd_queue_len - 1) % KEYBOARD_QUEUE_SIZE;
+	} else {
+		i = (kbd_queue_head + kbd_queue_len) % KEYBOARD_QUEUE_SIZE;
+		kbd_queue_len++;
+	}
+	memcpy(kbd_queue[i], report, KEYBOARD_REPORT_SIZE);
+}
+
+static int16_t accumulateMotion(int16_t acc, int16_t delta, int16_t max)
+{
+	acc += delta;
+	if (acc > max)
+		return max;
+	if (acc < -max)
+		return -max;
+	return acc;
+}
+
+static void dcReadPad(DcPort *port, unsigned char *report)
 {
-	static unsigned char err_count = 0;
 	unsigned char tmp[30];
-	static unsigned char func_data[4];
-	static int lcd_detect_count = 0;
 	int v;
 
-	switch (state)
+	switch (port->state)
 	{
 		case STATE_NULL:
 		{
@@ -363,179 +767,169 @@ static void dcReadPad(void)
 							MAPLE_ADDR_MAIN | MAPLE_ADDR_PORTA,
 							MAPLE_DC_ADDR, 0, NULL);
 			
-			state = STATE_GET_INFO;
+			port->state = STATE_GET_INFO;
 		}
 		break;
 
 		case STATE_GET_INFO:
 		{
+			if (port->probe_delay) {
+				port->probe_delay--;
+				break;
+			}
+
+			maple_setStartTimeout(MAPLE_START_TIMEOUT_US);
 			maple_sendFrame(MAPLE_CMD_RQ_DEV_INFO,
-							MAPLE_ADDR_MAIN | MAPLE_ADDR_PORTB,
-							MAPLE_DC_ADDR | MAPLE_ADDR_PORTB, 0, NULL);
+							MAPLE_ADDR_MAIN | port->addr,
+							MAPLE_DC_ADDR | port->addr, 0, NULL);
 
 			v = maple_receiveFrame(tmp, 30);
+			port->err_count = 0;
+
+			// Nothing connected. The bus stayed idle, so there is no need
+			// to wait, and the port is left alone for a while.
+			if (v == -1) {
+				port->probe_delay = EMPTY_PORT_PROBE_INTERVAL;
+				break;
+			}
 
 			// Too much data arrives and we stop listening before the controller stop transmitting. The delay
 			// here is to wait until the bus is idle again before continuing.
 			_delay_ms(2); 
-			if (v==-2) {
+
+			// The reply does not fit in tmp, but the first bytes are there.
+			if (v==-2 || v==-3) {
 				uint16_t func;
 
 				// 0-3 Header
 				// 4-7 Func
 				// ...
 				
-				func = tmp[4] | tmp[5]<<8;
+				func = tmp[7] | tmp[6]<<8;
 
 				if (func & MAPLE_FUNC_CONTROLLER) {
-					setConnectedDevice(MAPLE_FUNC_CONTROLLER);
-					state = STATE_LCD_DETECT;
-					lcd_detect_count = 0;
-				} else if (func & MAPLE_FUNC_MOUSE) {
-					state = STATE_READ_MOUSE;
-					memcpy(func_data, tmp + 5, 4);
-					setConnectedDevice(MAPLE_FUNC_MOUSE);
-				} else if (func & MAPLE_FUNC_KEYBOARD) {
-					state = STATE_READ_KEYBOARD;
-					setConnectedDevice(MAPLE_FUNC_KEYBOARD);
+					setConnectedDevice(port, MAPLE_FUNC_CONTROLLER);
+					port->state = STATE_READ_PAD;
 				}
-			}
-			
-			err_count = 0;
-		}
-		break;
-
-			// Try for 2 seconds to find the address of the LCD.
-			//
-			// After 2 seconds of trying, if found, send the
-			// image. 
-			//
-			// Sending the image right away after detection does not
-			// seem to work. This delay works around this.
-		case STATE_LCD_DETECT:
-		{
-			pollSubs();
-			if (!lcd_addr) 
-			{
-			}
-			else {
-				if (lcd_detect_count > 220) {
-					updateLcd(0);
-					state = STATE_BANNER_DISPLAY;
-					lcd_detect_count = 0;
-					break;
+#if MAPLE_NUM_PORTS == 1
+				// Only gamepads are reported with several ports
+#ifndef MAPLE_RX_SAMPLED
+				// The sampled receivers capture a fixed time, which
+				// ends before the pause in mouse replies is over.
+				else if (func & MAPLE_FUNC_MOUSE) {
+					port->state = STATE_READ_MOUSE;
+					memcpy(port->func_data, tmp + 4, 4);
+					setConnectedDevice(port, MAPLE_FUNC_MOUSE);
 				}
-			}
-			
-			lcd_detect_count++;
-
-			if (lcd_detect_count > 400) {
-				state = STATE_READ_PAD;
-			}
-		}
-		break;	
-
-		case STATE_BANNER_DISPLAY:
-		{
-			lcd_detect_count++;
-			if (lcd_detect_count > 400) {
-				updateLcd(1);
-				state = STATE_READ_PAD;
+#endif
+				else if (func & MAPLE_FUNC_KEYBOARD) {
+					port->state = STATE_READ_KEYBOARD;
+					setConnectedDevice(port, MAPLE_FUNC_KEYBOARD);
+				}
+#endif
 			}
 		}
 		break;
-		
+
 		case STATE_READ_MOUSE:
 		{
-			int16_t rel_x, rel_y;
+			int16_t rel_x, rel_y, rel_w;
 			uint8_t btns;
 			
-			maple_sendFrame1W(MAPLE_CMD_GET_CONDITION, 
-							MAPLE_ADDR_PORTB | MAPLE_ADDR_MAIN, 
-							MAPLE_ADDR_PORTB | MAPLE_DC_ADDR, 
-							MAPLE_FUNC_MOUSE);
+			// The mouse pauses in the middle of its reply. Extend the
+			// receive deadline so the wheel and the LRC are not cut off.
+			maple_setReplyPause(MOUSE_REPLY_PAUSE_US);
+			v = maple_sendReceiveFrame(port->condition_frame, sizeof(port->condition_frame), tmp, 30);
+			maple_setReplyPause(0);
+			adaptStartTimeout(port, v);
 
-			v = maple_receiveFrame(tmp, 30);
-			
-			// The mouse sends too much data, it fills the receive buffer. Also,
-			// there is a pause in the transmission that does not help.
-			// The wheel drata and the the LRC are missed.
-			//
-			// As such, mouse support is incomplete and a hack.
-			//
-/*			if (v==-2) {
-				err_count++;
-				if (err_count > MAX_ERRORS) {
-					state = STATE_RESET_DEVICE;
+			if (v<=0) {
+				port->err_count++;
+				if (port->err_count > MAX_ERRORS) {
+					port->state = STATE_GET_INFO;
 				}
 				return;
 			}
-			err_count = 0;
-*/	
+			port->err_count = 0;
+
+			if (v < 20)
+				return;
+
 			// 8  : Buttons
 			// 9  : Buttons
 			// 10 : Buttons
 			// 11 : Buttons 
-			// 12 : Y axis MSB
-			// 13 : Y axis LSB
-			// 14 : X axis MSB
-			// 15 : X axis LSB
+			// 12 : X axis LSB
+			// 13 : X axis MSB
+			// 14 : Y axis LSB
+			// 15 : Y axis MSB
 			//
-			// 16 : Wheel MSB
-			// 17 : Wheel LSB
+			// 16 : Wheel LSB
+			// 17 : Wheel MSB
 			
 
 			// bit 0 : Middle button
 			// bit 1 : Right button
 			// bit 2 : Left button
 			// bit 3 : Thumb button
-			tmp[11] ^= 0xf;
+			tmp[8] ^= 0xf;
 			btns = 0;
 
-			if (tmp[11] & 2) btns = 0x02; // DC Right -> USB btn 1
-			if (tmp[11] & 4) btns = 0x01; // DC Left  -> USB btn 0
+			if (tmp[8] & 2) btns = 0x02; // DC Right -> USB btn 1
+			if (tmp[8] & 4) btns = 0x01; // DC Left  -> USB btn 0
 
 			// If the mouse has a physical middle button, let it work
 			// normally. Otherwise, use the thumb button.
-			if (func_data[2] & 0x01) {
-				if (tmp[11] & 1) btns = 0x04; // DC Middle -> USB btn 2
-				if (tmp[11] & 8) btns = 0x08; // DC Thumb -> USB btn 3
+			if (port->func_data[0] & 0x01) {
+				if (tmp[8] & 1) btns = 0x04; // DC Middle -> USB btn 2
+				if (tmp[8] & 8) btns = 0x08; // DC Thumb -> USB btn 3
 			} else {
-				if (tmp[11] & 8) btns = 0x04; // DC Thumb -> btn 2
+				if (tmp[8] & 8) btns = 0x04; // DC Thumb -> btn 2
 			}
 
-			rel_x = (tmp[15] | tmp[14]<<8) - 0x200;
-			rel_y = (tmp[13] | tmp[12]<<8) - 0x200;
-
-			last_built_report[0][0] = btns;
-			last_built_report[0][1] = rel_x & 0xff;
-			last_built_report[0][2] = rel_x >> 8;
-			last_built_report[0][3] = rel_y & 0xff;
-			last_built_report[0][4] = rel_y >> 8;
+			rel_x = (tmp[12] | tmp[13]<<8) - 0x200;
+			rel_y = (tmp[14] | tmp[15]<<8) - 0x200;
+			rel_w = (tmp[16] | tmp[17]<<8) - 0x200;
+
+			// The mouse is polled more often than the host reads the
+			// reports. Motion adds up until dcBuildReport() sends it.
+			port->motion_x = accumulateMotion(port->motion_x, rel_x, MOUSE_MAX_XY);
+			port->motion_y = accumulateMotion(port->motion_y, rel_y, MOUSE_MAX_XY);
+			port->motion_w = accumulateMotion(port->motion_w, rel_w, MOUSE_MAX_WHEEL);
+
+			report[0] = btns;
+			report[1] = port->motion_x & 0xff;
+			report[2] = port->motion_x >> 8;
+			report[3] = port->motion_y & 0xff;
+			report[4] = port->motion_y >> 8;
+			report[5] = port->motion_w;
+			port->report_dirty = 1;
 		}
 		break;
 
 		case STATE_READ_PAD:
 		{
-			maple_sendFrame1W(MAPLE_CMD_GET_CONDITION, 
-							MAPLE_ADDR_PORTB | MAPLE_ADDR_MAIN, 
-							MAPLE_DC_ADDR | MAPLE_ADDR_PORTB,
-							MAPLE_FUNC_CONTROLLER);
-
-			v = maple_receiveFrame(tmp, 30);
+			v = maple_sendReceiveFrame(port->condition_frame, sizeof(port->condition_frame), tmp, 30);
+			adaptStartTimeout(port, v);
 			
 			if (v<=0) {
-				err_count++;
-				if (err_count > MAX_ERRORS) {
-					state = STATE_GET_INFO;
+				port->err_count++;
+				if (port->err_count > MAX_ERRORS) {
+					port->state = STATE_GET_INFO;
 				}
 				return;
 			}
-			err_count = 0;
+			port->err_count = 0;
+
+			// 2 : Source address
+			updateSubs(port, tmp[2] & 0x1f);
 
 			if (v < 16)
 				return;	
 
+			if (conditionUnchanged(port, tmp + 8))
+				return;
+
 			// 8 : Buttons
 			// 9 : Buttons
 			// 10 : R trig
@@ -544,36 +938,42 @@ static void dcReadPad(void)
 			// 13 : Joy Y axis
 			// 14 : Joy X2 axis
 			// 15 : Joy Y2 axis
-			last_built_report[0][0] = tmp[12];
-			last_built_report[0][1] = tmp[13];
-			last_built_report[0][2] = tmp[10] / 2 + 0x80;
-			last_built_report[0][3] = tmp[11] / 2 + 0x80;
-			last_built_report[0][4] = tmp[8] ^ 0xff;
-			last_built_report[0][5] = tmp[9] ^ 0xff;
+			report[0] = tmp[12];
+			report[1] = tmp[13];
+			report[2] = tmp[10] / 2 + 0x80;
+			report[3] = tmp[11] / 2 + 0x80;
+			report[4] = tmp[8] ^ 0xff;
+			report[5] = tmp[9] ^ 0xff;
+			port->report_dirty = 1;
 		}
 		break;
 
 		case STATE_READ_KEYBOARD:
 		{
-			maple_sendFrame1W(MAPLE_CMD_GET_CONDITION, 
-							MAPLE_ADDR_PORTB | MAPLE_ADDR_MAIN, 
-							MAPLE_DC_ADDR | MAPLE_ADDR_PORTB,
-							MAPLE_FUNC_KEYBOARD);
+			// Pending LED changes go out just before the poll, which
+			// still takes place as usual.
+			if (kbd_leds_pending) {
+				setKeyboardLeds(port);
+			}
 
-			v = maple_receiveFrame(tmp, 30);
+			v = maple_sendReceiveFrame(port->condition_frame, sizeof(port->condition_frame), tmp, 30);
+			adaptStartTimeout(port, v);
 
 			if (v<=0) {
-				err_count++;
-				if (err_count > MAX_ERRORS) {
-					state = STATE_GET_INFO;
+				port->err_count++;
+				if (port->err_count > MAX_ERRORS) {
+					port->state = STATE_GET_INFO;
 				}
 				return;
 			}
-			err_count = 0;
+			port->err_count = 0;
 			
 			if (v < 16)
 				return;	
 
+			if (conditionUnchanged(port, tmp + 8))
+				return;
+
 			// Dreamcast data
 			// 
 			// 8 : shift
@@ -592,12 +992,11 @@ static void dcReadPad(void)
 			// Compare http://mc.pp.se/dc/kbd.html and
 			// the USB HID Usage Table document table (10 Keyboard/Keypad Page (0x07))
 			//
-			last_built_report[0][0] = tmp[8]; // shift keys
-			last_built_report[0][1] = 0; // Reserved
-			last_built_report[0][2] = tmp[10];
-			last_built_report[0][3] = tmp[11];
-			last_built_report[0][4] = tmp[12];
-			last_built_report[0][5] = tmp[13];
+			report[0] = tmp[8]; // shift keys
+			report[1] = 0; // Reserved
+			memcpy(report + 2, tmp + 10, 6);
+			queueKeyboardReport(report);
+			port->report_dirty = 1;
 		}
 		break;
 	}
@@ -605,35 +1004,109 @@ static void dcReadPad(void)
 
 static void dcUpdate(void)
 {
-	dcReadPad();
+	static unsigned char rumble_next;
+	unsigned char p, q;
+
+	// All ports are read at each poll, one after the other, so each
+	// player gets the same latency as with a single port adapter.
+	for (p=0; p<MAPLE_NUM_PORTS; p++) {
+		maple_selectPort(p);
+		maple_setStartTimeout(ports[p].start_timeout);
+		dcReadPad(&ports[p], last_built_report[p] + REPORT_ID_SIZE);
+	}
+
+	// At most one rumble command per update, after the polls, so the
+	// next poll is never late by more than one transaction.
+	for (p=0; p<MAPLE_NUM_PORTS; p++) {
+		q = (rumble_next + p) % MAPLE_NUM_PORTS;
+		if (ports[q].rumble_pending) {
+			maple_selectPort(q);
+			setRumble(&ports[q]);
+			rumble_next = q + 1;
+			break;
+		}
+	}
+}
+
+// Report IDs start at 1. Without IDs (single port), 0 is used.
+static unsigned char reportIndex(unsigned char report_id)
+{
+	if (report_id == 0 || report_id > NUM_REPORTS)
+		return 0;
+	return report_id - 1;
 }
 
 static char dcBuildReport(unsigned char *reportBuffer, unsigned char report_id)
 {
-	report_id = 0;
+	unsigned char i = reportIndex(report_id);
+
+	// Send the queued keyboard states in order. The last one queued is
+	// the current state, last_built_report is up to date once drained.
+	if (kbd_queue_len && ports[i].connected_device == MAPLE_FUNC_KEYBOARD) {
+		memcpy(last_built_report[i] + REPORT_ID_SIZE, kbd_queue[kbd_queue_head], KEYBOARD_REPORT_SIZE);
+		kbd_queue_head = (kbd_queue_head + 1) % KEYBOARD_QUEUE_SIZE;
+		kbd_queue_len--;
+	}
 
 	if (reportBuffer != NULL)
 	{
-		memcpy(reportBuffer, last_built_report[report_id], cur_report_size);
+		memcpy(reportBuffer, last_built_report[i], cur_report_size);
+	}
+
+	if (ports[i].connected_device == MAPLE_FUNC_MOUSE) {
+		// The host now has the motion, only the buttons remain
+		ports[i].motion_x = ports[i].motion_y = ports[i].motion_w = 0;
+		memset(last_built_report[i] + REPORT_ID_SIZE + 1, 0, MOUSE_REPORT_SIZE - 1);
 	}
-	memcpy(last_sent_report[report_id], last_built_report[report_id], cur_report_size);	
+	memcpy(last_sent_report[i], last_built_report[i], cur_report_size);
 
 	return cur_report_size;
 }
 
 static char dcChanged(unsigned char report_id)
 {
-	report_id = 0;
+	unsigned char i = reportIndex(report_id);
+
+	if (kbd_queue_len && ports[i].connected_device == MAPLE_FUNC_KEYBOARD) {
+		ports[i].report_dirty = 0;
+		return 1;
+	}
+
+	if (!ports[i].report_dirty)
+		return 0;
+	ports[i].report_dirty = 0;
 
-	return memcmp(last_built_report[report_id], last_sent_report[report_id], cur_report_size);
+	return memcmp(last_built_report[i], last_sent_report[i], cur_report_size);
+}
+
+static void dcSetReport(unsigned char report_id, unsigned char *buf, unsigned char len)
+{
+	unsigned char i = reportIndex(report_id);
+
+	if (len <= REPORT_ID_SIZE)
+		return;
+
+	switch (ports[i].connected_device)
+	{
+		case MAPLE_FUNC_KEYBOARD:
+			kbd_leds = buf[REPORT_ID_SIZE];
+			kbd_leds_pending = SET_CONDITION_TRIES;
+			break;
+
+		case MAPLE_FUNC_CONTROLLER:
+			ports[i].rumble = buf[REPORT_ID_SIZE];
+			ports[i].rumble_pending = SET_CONDITION_TRIES;
+			break;
+	}
 }
 
 static Gamepad dcGamepad = {
-	num_reports: 		1,
+	num_reports: 		NUM_REPORTS,
 	init: 				dcInit,
 	update: 			dcUpdate,
 	changed:			dcChanged,
 	buildReport:		dcBuildReport,
+	setReport:			dcSetReport,
 	descriptorsChanged:	dcDescriptorsChanged,
 };
 
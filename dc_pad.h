@@ -1,4 +1,24 @@
+#include <stdint.h>
 #include "gamepad.h"
 
 Gamepad *dcGetGamepad(void);
 
+/* Vendor request returning a LatencyStats. wIndex selects the port. */
+#define DC_RQ_GET_LATENCY_STATS	0x01
+
+/* Reply latency of the connected device, in microseconds. Measured from
+ * the end of each frame sent to the start of the reply. Reset when a
+ * different device is connected. */
+typedef struct {
+	uint16_t func;		// MAPLE_FUNC_* of the connected device
+	uint16_t count;		// Replies measured
+	uint16_t min_us;
+	uint16_t max_us;
+	uint16_t mean_us;
+	uint16_t last_us;
+	uint16_t timeouts;	// Polls without a reply
+	uint16_t start_timeout_us; // Currently allowed (see maple_setStartTimeout)
+} LatencyStats;
+
+void dcGetLatencyStats(LatencyStats *dst, unsigned char port);
+
@@ -16,6 +16,11 @@ typedef struct {
 	void (*init)(void);
 	void (*update)(void);
 
+	/**
+	 * \param id Controller id (starting at 1 to match report IDs)
+	 * \return Non-zero when a report must be sent. Also called right after
+	 *         buildReport(), for gamepads with several reports pending.
+	 * */
 	char (*changed)(unsigned char id);
 	/**
 	 * \param id Controller id (starting at 1 to match report IDs)
@@ -23,6 +28,16 @@ typedef struct {
 	 * */
 	char (*buildReport)(unsigned char *buf, unsigned char id);
 
+	/**
+	 * Output report from the host (SET_REPORT). May be NULL. Called from
+	 * usbPoll(), so it must not talk to the controllers.
+	 *
+	 * \param id Report ID from the request
+	 * \param buf The report, including the ID if report IDs are used
+	 * \param len At most 8 bytes
+	 * */
+	void (*setReport)(unsigned char id, unsigned char *buf, unsigned char len);
+
 } Gamepad;
 
 #endif // _gamepad_h__
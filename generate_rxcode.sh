@@ -1,11 +1,89 @@
 #!/bin/bash
+#
+# Usage: [NSAMPLES=n] [SAMPLE_CYCLES=n] generate_rxcode.sh [packed]
+#
+# Without argument, one PINC sample per byte every SAMPLE_CYCLES cycles
+# (rxcode.asm). The default of 3 is the fastest possible (in + st), longer
+# periods are padded with nops. NSAMPLES + 1 samples are stored, which
+# must match MAPLE_RX_NSAMPLES in maplebus.c (the Makefile passes both).
+#
+# A bit lasts F_CPU / 2MHz cycles on the wire, so the default gives 2, 2.67
+# and 3.33 samples per bit at 12, 16 and 20MHz. The decoder needs at least 2.
+#
+# With 'packed', four samples per byte every 4 cycles (rxcode_packed.asm).
+# Samples are read every 4 cycles and packed in a loop, two bits
+# (pin 5, pin 1) per sample, first sample in the upper bits.
+#
+# Packing relies on PC2-PC5 reading 0 (maple_init makes them low outputs).
+# PC6 (RESET) reads as a constant and shows up in bits 6 and 2 of each
+# byte, so the decoder must xor each byte with 0x44 when PINC6 is set.
+# The first stored byte is garbage (the pipeline is not primed yet).
+#
+# The settings are also output as RXCODE_* defines, which maplebus.c
+# checks against its own.
+#
 
-NSAMPLES=640
+NSAMPLES=${NSAMPLES:-640}
+SAMPLE_CYCLES=${SAMPLE_CYCLES:-3}
+
+# Packed mode: 4 groups of 4 samples per iteration keeps the brtc
+# back to the top of the loop in range.
+# NSAMPLES bytes are stored, NSAMPLES must be a multiple of PACKED_GROUPS.
+PACKED_BYTES=$NSAMPLES
+PACKED_GROUPS=4
+PACKED_ITERATIONS=$(( PACKED_BYTES / PACKED_GROUPS ))
+
+if [ "$1" = "packed" ]; then
+	echo "// Generated by generate_rxcode.sh packed"
+	echo "// Number of samples: $(( PACKED_BYTES * 4 ))"
+	echo "#define RXCODE_PACKED_BYTES $PACKED_BYTES"
+
+	# r25:r24 reaches 0x8000 (bit 15 set) after PACKED_ITERATIONS increments
+	start=$(( 0x8000 - PACKED_ITERATIONS ))
+	echo "\"   ldi r24, lo8($start)\n   ldi r25, hi8($start)   \n\""
+	echo "\"rx_packed_loop%=:   \n\""
+
+	s=0
+	for g in `seq 1 $PACKED_GROUPS`
+	do
+		# Alternate accumulators. P holds the previous group, completed
+		# and stored while this group is captured.
+		if [ $(( g % 2 )) -eq 1 ]; then A=r16; P=r20; else A=r20; P=r16; fi
+
+		case $g in
+			1) extra="   adiw r24, 1" ;;
+			2) extra="   bst r25, 7\n   nop" ;;
+			$PACKED_GROUPS) extra="   brtc rx_packed_loop%=" ;;
+			*) extra="   nop\n   nop" ;;
+		esac
+
+		echo "\"   in $A, %[pin]\n   lsl $A\n   lsl $A\n   eor $P, r18   \n\" // sample $s"
+		echo "\"   in r17, %[pin]\n   eor $A, r17\n   st z+, $P   \n\" // sample $(( s + 1 ))"
+		echo "\"   in r18, %[pin]\n   lsl r18\n   lsl r18\n   swap $A   \n\" // sample $(( s + 2 ))"
+		echo "\"   in r17, %[pin]\n   eor r18, r17\n$extra   \n\" // sample $(( s + 3 ))"
+		s=$(( s + 4 ))
+	done
+	exit 0
+fi
+
+if [ $SAMPLE_CYCLES -lt 3 ]; then
+	echo "SAMPLE_CYCLES must be at least 3" >&2
+	exit 1
+fi
+
+PAD=""
+for i in `seq 4 $SAMPLE_CYCLES`
+do
+	PAD="$PAD   nop\n"
+done
 
 echo "// Generated by generate_rxcode.sh"
 echo "// Number of samples: $NSAMPLES"
+echo "// Cycles per sample: $SAMPLE_CYCLES"
+echo "#define RXCODE_NSAMPLES $NSAMPLES"
+echo "#define RXCODE_SAMPLE_CYCLES $SAMPLE_CYCLES"
 
-for i in `seq 0 $NSAMPLES` 
-	do 
-		echo "\"   in r16, %1\n   st z+, r16   \n\" // sample $i "
+for i in `seq 0 $NSAMPLES`
+	do
+		echo "\"   in r16, %[pin]\n   st z+, r16   \n$PAD\" // sample $i "
 done
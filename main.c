@@ -45,6 +45,13 @@ static usbMsgLen_t rt_usbDeviceDescriptorSize = 0;
 #define AT168_COMPATIBLE
 #endif
 
+// Timer2 (F_CPU/1024) compare value for polling controllers at about
+// 300Hz, whatever the clock (50 at 16MHz).
+#define POLL_OCR	(F_CPU / 1024 / 306 - 1)
+
+// Time between controller polls, in 1/4 ms (13 at 16MHz)
+#define POLL_PERIOD_QMS	((POLL_OCR + 1) * 1024UL * 4000 / F_CPU)
+
 
 
 const PROGMEM int usbDescriptorStringSerialNumber[]  = {
@@ -129,6 +136,8 @@ static void hardwareInit(void)
 	 * Bit 
 	 * 0        Pin 1
 	 * 1        Pin 5
+	 * 2, 3     Pin 1, pin 5 of the second port (MAPLE_NUM_PORTS > 1)
+	 * 4, 5     Pin 1, pin 5 of the third port (MAPLE_NUM_PORTS > 2)
 	 */
 	DDRC = 0x00;
 	PORTC = 0xff;
@@ -151,11 +160,11 @@ static void hardwareInit(void)
 	TCCR2A= (1<<WGM21);
 	TCCR2B=(1<<CS22)|(1<<CS21)|(1<<CS20);
 //	OCR2A=196;  // for 60 hz
-	OCR2A=50;  // for 60 hz
+	OCR2A=POLL_OCR;
 #else
 	TCCR2 = (1<<WGM21)|(1<<CS22)|(1<<CS21)|(1<<CS20);
 	//OCR2 = 196; // for 60 hz
-	OCR2 = 50; // for 60 hz
+	OCR2 = POLL_OCR;
 #endif
 }
 
@@ -189,6 +198,16 @@ static void usbReset(void)
 
 static uchar    reportBuffer[16];    /* buffer for HID reports */
 
+// One bit per report in must_report
+#define MAX_REPORTS		8
+
+/* Idle rate of each report (SET_IDLE), in 4ms units. 0 sends reports only
+ * when they change. Otherwise, an unchanged report is sent again once
+ * that long has elapsed since it was last sent. */
+static uchar idleRate[MAX_REPORTS];
+// Time since each report was last sent, in 1/4 ms (counts up to the idle rate)
+static unsigned int idleElapsed[MAX_REPORTS];
+
 /* ------------------------------------------------------------------------- */
 /* ----------------------------- USB interface ----------------------------- */
 /* ------------------------------------------------------------------------- */
@@ -219,6 +238,9 @@ usbMsgLen_t usbFunctionDescriptor(struct usbRequest *rq)
 	return 0;
 }
 
+// Report ID of the SET_REPORT request in progress
+static uchar setReportId;
+
 usbMsgLen_t usbFunctionSetup(uchar data[8])
 {
 	usbRequest_t    *rq = (void *)data;
@@ -228,12 +250,46 @@ usbMsgLen_t usbFunctionSetup(uchar data[8])
 		if(rq->bRequest == USBRQ_HID_GET_REPORT){  /* wValue: ReportType (highbyte), ReportID (lowbyte) */
 			return curGamepad->buildReport(reportBuffer, rq->wValue.bytes[0]);
 		}
-	}else{
-		/* no vendor specific requests implemented */
+		if(rq->bRequest == USBRQ_HID_SET_REPORT){
+			if (!curGamepad->setReport)
+				return 0;
+			setReportId = rq->wValue.bytes[0];
+			return USB_NO_MSG; /* data comes through usbFunctionWrite() */
+		}
+		if(rq->bRequest == USBRQ_HID_SET_IDLE){ /* wValue: Duration (highbyte), ReportID (lowbyte) */
+			uchar i, id = rq->wValue.bytes[0];
+
+			for (i=0; i<MAX_REPORTS; i++) {
+				// Report ID 0 applies to all reports
+				if (!id || id == i+1) {
+					idleRate[i] = rq->wValue.bytes[1];
+					idleElapsed[i] = 0;
+				}
+			}
+			return 0;
+		}
+		if(rq->bRequest == USBRQ_HID_GET_IDLE){
+			uchar id = rq->wValue.bytes[0];
+
+			reportBuffer[0] = (id && id <= MAX_REPORTS) ? idleRate[id-1] : idleRate[0];
+			return 1;
+		}
+	}else if((rq->bmRequestType & USBRQ_TYPE_MASK) == USBRQ_TYPE_VENDOR){
+		if(rq->bRequest == DC_RQ_GET_LATENCY_STATS){
+			dcGetLatencyStats((void*)reportBuffer, rq->wIndex.bytes[0]);
+			return sizeof(LatencyStats);
+		}
 	}
 	return 0;
 }
 
+uchar usbFunctionWrite(uchar *data, uchar len)
+{
+	// Output reports are small enough for a single packet
+	curGamepad->setReport(setReportId, data, len);
+	return 1;
+}
+
 /* ------------------------------------------------------------------------- */
 
 
@@ -288,6 +344,15 @@ reconnect:
 				if (curGamepad->changed(i+1)) {
 					must_report |= (1<<i);
 				}
+				else if (idleRate[i]) {
+					// Repeat unchanged reports at the idle rate
+					if (idleElapsed[i] < idleRate[i] * 16) {
+						idleElapsed[i] += POLL_PERIOD_QMS;
+					}
+					if (idleElapsed[i] >= idleRate[i] * 16) {
+						must_report |= (1<<i);
+					}
+				}
 			}
 			
 		}
@@ -300,12 +365,20 @@ reconnect:
 				if (!(must_report & (1<<i)))
 					continue;
 
+				// Keep polling the controllers while the host has
+				// not read the previous report. The gamepad keeps what
+				// it needs to send (see changed()) until then.
+				if (!usbInterruptIsReady())
+					break;
+
 				len = curGamepad->buildReport(reportBuffer, i+1);
-				while(!usbInterruptIsReady()) {
-					usbPoll();
-				}
 				usbSetInterrupt(reportBuffer, len);
-				must_report &= ~(1<<i);
+				idleElapsed[i] = 0;
+
+				// More may be queued (keyboard)
+				if (!curGamepad->changed(i+1)) {
+					must_report &= ~(1<<i);
+				}
 			}
 			
 		}
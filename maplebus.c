@@ -18,6 +18,7 @@
  * The author may be contacted at raph@raphnet.net
  */
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <avr/pgmspace.h>
 #include <util/delay.h>
 #include <string.h>
@@ -29,57 +30,286 @@
 #undef TRACE_DECODED
 #define TRACE_PIN1_BITS
 
+// The receiver (MAPLE_RX_SAMPLED or not) is selected in maplebus.h
+
+// Samples and sampling period of rxcode.asm. Normally set by the Makefile,
+// must match NSAMPLES and SAMPLE_CYCLES in generate_rxcode.sh.
+#ifndef MAPLE_RX_NSAMPLES
+#define MAPLE_RX_NSAMPLES		640
+#endif
+#ifndef MAPLE_RX_SAMPLE_CYCLES
+#define MAPLE_RX_SAMPLE_CYCLES	3
+#endif
+
+#ifdef MAPLE_RX_SAMPLED
+#ifdef MAPLE_RX_PACKED
+#define MAPLE_RX_PERIOD			4
+#else
+#define MAPLE_RX_PERIOD			MAPLE_RX_SAMPLE_CYCLES
+#endif
+#if MAPLE_RX_PERIOD * 2 > MAPLE_CYCLES_PER_BIT
+#error The decoder needs at least 2 samples per bit
+#endif
+#endif
+
+//
 //
+// PORTC0 : Pin 1 (port 0)
+// PORTC1 : Pin 5 (port 0)
+// PORTC2 : Pin 1 (port 1)
+// PORTC3 : Pin 5 (port 1)
+// PORTC4 : Pin 1 (port 2)
+// PORTC5 : Pin 5 (port 2)
 //
-// PORTC0 : Pin 1
-// PORTC1 : Pin 5
+// PORTC6 is RESET, so there is no room for a fourth port.
 //
+#if MAPLE_NUM_PORTS < 1 || MAPLE_NUM_PORTS > 3
+#error MAPLE_NUM_PORTS must be 1, 2 or 3
+#endif
+// maplebuf alone takes most of the RAM, there is no room for the
+// state of more ports. Multi-port builds need 20MHz.
+#if MAPLE_NUM_PORTS > 1 && defined(MAPLE_RX_SAMPLED)
+#error The sampled receivers are for single port builds only
+#endif
+
+#define MAPLE_PORTS_MASK	((1 << (MAPLE_NUM_PORTS * 2)) - 1)
+
+// Timer1 runs at F_CPU/8
+#define US_TO_TICKS(us)	((us) * (F_CPU / 1000) / 8000)
+#define TICKS_TO_US(t)	((t) * 8000UL / (F_CPU / 1000))
+
+// Receive deadline, counted from the start of frame. Pauses within the
+// reply (see maple_setReplyPause()) come on top.
+#define MAPLE_RX_US_PER_BYTE	5 // 4us on the wire
+#define MAPLE_RX_US_SLACK		20
+
+// The selected port and its pins in PORTC
+static unsigned char cur_port;
+static unsigned char cur_pins;
+
+// PORTC values for the transmit code, see TX_LOAD
+static unsigned char tx_levels[6];
 
 void maple_init(void)
 {
-	DDRC = 0xFC;
-	PORTC = 0x03;
+	DDRC = ~MAPLE_PORTS_MASK;
+	PORTC = MAPLE_PORTS_MASK;
+	maple_selectPort(0);
+
+	TCCR1A = 0;
+	TCCR1B = (1<<CS11);
+}
+
+void maple_selectPort(unsigned char port)
+{
+	unsigned char pin1 = 1 << (port * 2);
+	unsigned char pin5 = pin1 << 1;
+	// The lines of the other ports stay high while transmitting
+	unsigned char others = MAPLE_PORTS_MASK & ~(pin1 | pin5);
+
+	cur_port = port;
+	cur_pins = pin1 | pin5;
+
+	tx_levels[0] = others | pin1;
+	tx_levels[1] = others | pin5;
+	tx_levels[2] = pin5;
+	tx_levels[3] = pin1;
+	tx_levels[4] = others | pin1 | pin5;
+	tx_levels[5] = others;
 }
-#define transmitMode()	do { PORTC |= 0x03; DDRC |= 0x03; } while(0)
-#define inputMode() do { PORTC |= 0x03; DDRC &= ~0x03; } while(0)
+
+#define transmitMode()	do { PORTC |= cur_pins; DDRC |= cur_pins; } while(0)
+#define inputMode() do { PORTC |= cur_pins; DDRC &= ~cur_pins; } while(0)
 #define nop() asm volatile("nop\n");
 
-#define MAPLE_BUF_SIZE	641
+#ifdef MAPLE_RX_SAMPLED
+// Only used for reception
+#define MAPLE_BUF_SIZE	(MAPLE_RX_NSAMPLES + 1)
 volatile unsigned char maplebuf[MAPLE_BUF_SIZE];
-static unsigned char buf_used;
-static unsigned char buf_phase;
+#endif
 
-#define PIN_1	0x01
-#define PIN_5	0x02
-static void buf_reset(void)
+// A macro holding a plain number (such as the bit numbers from avr/io.h)
+// as asm text. GCC allows no more than 30 operands per asm statement, so
+// constants which do not need one are written in the text.
+#define STR_(x)			#x
+#define STR(x)			STR_(x)
+
+// Pin 1 and pin 5 of the selected port. The PORTC value for each
+// state of the lines is kept in a register (see TX_LOAD), with the lines
+// of the other ports high. Each change takes 2 cycles, like sbi/cbi.
+#define TX_LINES(reg)	"	out %[port], " reg "	\n	nop	\n"
+#define TX_BOTH			TX_LINES("r18")
+#define TX_NONE			TX_LINES("r19")
+#define TX_ONLY_1		TX_LINES("r20")
+#define TX_ONLY_5		TX_LINES("r21")
+
+// The delays were tuned at 16MHz, %[mhz] scales them to F_CPU. The
+// assembler works the count out, which saves an asm operand per delay.
+#define DLY(cycles)	"	.rept " #cycles " * %[mhz] / 16\n	nop\n	.endr\n"
+#define DLY_8		DLY(8)
+#define DLY_5		DLY(5)
+#define DLY_4		DLY(4)
+#define DLY_3		DLY(3)
+#define DLY_PAD		"	.rept %[pad]\n	nop\n	.endr\n"
+
+// Phases take 8 cycles on average at 16MHz. Above, pad each
+// phase to keep the bit rate. Below, bits are just sent a bit
+// slower.
+#define TX_PAD			(MAPLE_CYCLES_PER_BIT > 8 ? (MAPLE_CYCLES_PER_BIT - 8) : 0)
+
+// Load tx_levels (see maple_selectPort()) in r18 to r23:
+//  r20 : pin 1 high, r21 : pin 5 high
+//  r22 : pin 5 bit, r23 : pin 1 bit
+//  r18 : both high, r19 : both low
+// TX_RELOAD only restores r18 and r19, which the byte loops reuse.
+#define TX_RELOAD		"	lds r18, %[levels]+4	\n" \
+						"	lds r19, %[levels]+5	\n"
+#define TX_LOAD			"	lds r20, %[levels]		\n" \
+						"	lds r21, %[levels]+1	\n" \
+						"	lds r22, %[levels]+2	\n" \
+						"	lds r23, %[levels]+3	\n" \
+						TX_RELOAD
+
+// One phase. The clock pin goes high (with the other pin low),
+// the data bit is output on the other pin, then the clock falls.
+// The value for PORTC is prepared with sbrc/or, which takes the
+// same time for 0 and 1. 7 cycles, plus the extra instructions.
+//
+// or and eor change the flags. Loops save the Z flag right after
+// counting (in r19, __SREG__) and test it with TX_LOOP.
+#define TX_PHASE1(bit, extra)	\
+						"	mov r17, r20		\n" /* 1 */ \
+						"	sbrc r16, " #bit "	\n" /* 2 */ \
+						"	or r17, r22			\n" /* data on pin 5 */ \
+						extra \
+						"	out %[port], r20	\n" /* 1 pin 1 high */ \
+						"	out %[port], r17	\n" /* 1 */ \
+						"	eor r17, r23		\n" /* 1 */ \
+						"	out %[port], r17	\n" /* 1 falling edge on pin 1 */ \
+						DLY_PAD
+#define TX_PHASE2(bit, extra)	\
+						"	mov r17, r21		\n" /* 1 */ \
+						"	sbrc r16, " #bit "	\n" /* 2 */ \
+						"	or r17, r23			\n" /* data on pin 1 */ \
+						extra \
+						"	out %[port], r21	\n" /* 1 pin 5 high */ \
+						"	out %[port], r17	\n" /* 1 */ \
+						"	eor r17, r22		\n" /* 1 */ \
+						"	out %[port], r17	\n" /* 1 falling edge on pin 5 */ \
+						DLY_PAD
+
+// A whole byte from r16, with extra instructions in each phase
+#define TX_BYTE(e7, e6, e5, e4, e3, e2, e1, e0)	\
+						TX_PHASE1(7, e7) TX_PHASE2(6, e6) \
+						TX_PHASE1(5, e5) TX_PHASE2(4, e4) \
+						TX_PHASE1(3, e3) TX_PHASE2(2, e2) \
+						TX_PHASE1(1, e1) TX_PHASE2(0, e0)
+#define TX_NOP			"	nop					\n"
+#define TX_COUNT(reg)	"	sbiw " reg ", 1		\n" /* 2 */ \
+						"	in r19, __SREG__	\n" /* 1 */
+#define TX_LOOP(label)	"	sbrs r19, 1			\n" /* 1 Z saved by TX_COUNT */ \
+						"	rjmp " label "		\n" /* 2 */
+#define TX_SYNC			TX_BOTH DLY_8 \
+						TX_ONLY_5 DLY_4 \
+						TX_NONE DLY_3 \
+						TX_ONLY_5 DLY_3 TX_NONE DLY_3 \
+						TX_ONLY_5 DLY_3 TX_NONE DLY_3 \
+						TX_ONLY_5 DLY_3 TX_NONE DLY_3 \
+						TX_ONLY_5 DLY_5 TX_BOTH TX_ONLY_1
+#define TX_END			TX_ONLY_1 TX_RELOAD DLY_4 \
+						TX_BOTH TX_ONLY_1 DLY_3 \
+						TX_NONE DLY_3 \
+						TX_ONLY_1 DLY_3 \
+						TX_NONE DLY_3 \
+						TX_ONLY_1 DLY_3 \
+						TX_BOTH
+
+// Send %[txcount] bytes from X, sync and end of frame sequences included.
+// Uses r16 to r23.
+//
+// Bits are shifted out of the source bytes directly. The loop overhead
+// is spread over the phases so the clock falls every 7 to 10 cycles,
+// 64 cycles (4us) per byte at 16Mhz: 10 (loop), 7, 7, 7, 10, 7, 7, 9.
+#define TX_FRAME		TX_LOAD \
+						"	ld r16, x+			\n" \
+						TX_SYNC \
+						"tx_byte%=:				\n" \
+						TX_BYTE("", "", "", "", TX_COUNT("%[txcount]"), \
+								"", "", "	ld r16, x+	\n") \
+						TX_LOOP("tx_byte%=") \
+						TX_END
+
+// Time allowed for the reply to start, and time it took for the last one.
+static unsigned int rx_start_ticks = US_TO_TICKS(MAPLE_START_TIMEOUT_US);
+static unsigned int rx_wait_start;
+static unsigned int rx_latency;
+
+// Timer1 count when the last frame was sent
+static unsigned int tx_end;
+
+// Extra time for pauses within replies
+static unsigned int rx_pause_us;
+
+void maple_setStartTimeout(unsigned int us)
 {
-	buf_used = 0;
-	buf_phase = 0;
+	rx_start_ticks = US_TO_TICKS(us);
 }
 
-static void buf_addBit(char value)
+void maple_setReplyPause(unsigned int us)
 {
-	// The values in maplebuf will be written
-	// directly to PORTC. Unused bits will be low.
-	if (buf_phase & 0x01) {
-		maplebuf[buf_used] = PIN_5;
-		if (value) {
-			maplebuf[buf_used] |= PIN_1; // prepare data
-		}
-		buf_used++;
-	}
-	else {
-		maplebuf[buf_used] = PIN_1;
-		if (value) {
-			maplebuf[buf_used] |= PIN_5; // prepare data
-		}
-		buf_used++;
+	rx_pause_us = us;
+}
+
+unsigned int maple_getLatency(void)
+{
+	return TICKS_TO_US(rx_latency);
+}
+
+#ifdef MAPLE_RX_SAMPLED
+// Start waiting for a reply. OCF1B gets set when the time is up.
+static void rx_armStartTimeout(void)
+{
+	rx_wait_start = TCNT1;
+	OCR1B = rx_wait_start + rx_start_ticks;
+	TIFR1 = 1<<OCF1B;
+}
+#endif
+
+#ifdef MAPLE_RX_SAMPLED
+
+// Pin 1 and pin 5 in bits 0 and 1
+#define rx_pins(s)	((s) & 0x03)
+
+#ifdef MAPLE_RX_PACKED
+// maplebuf[0] is not a capture (see generate_rxcode.sh), and the
+// capture stores MAPLE_RX_NSAMPLES bytes: the last byte is not written.
+#define MAPLE_RX_SAMPLES	((MAPLE_BUF_SIZE - 2) * 4)
+
+// PC6 (RESET) reads as a constant which gets mixed
+// in bits 6 and 2 of each packed byte.
+static unsigned char rx_fix;
+
+static unsigned char rx_sample(int i)
+{
+	unsigned char b = maplebuf[1 + (i >> 2)] ^ rx_fix;
+
+	switch (i & 3)
+	{
+		case 0: return b >> 6;
+		case 1: return (b >> 4) & 0x03;
+		case 2: return (b >> 2) & 0x03;
 	}
-	buf_phase ^= 1;
+	return b & 0x03;
 }
+#else
+#define MAPLE_RX_SAMPLES	MAPLE_BUF_SIZE
+#define rx_sample(i)		rx_pins(maplebuf[i])
+#endif
 
-static int maplebus_decode(unsigned char *data, unsigned int maxlen)
+static int maplebus_decode(unsigned char *data, unsigned int maxlen, unsigned char *lrc)
 {
+	unsigned char sum = 0;
+	unsigned char b;
 	unsigned char dst_b;
 	unsigned int dst_pos;
 	unsigned char last;
@@ -98,22 +328,22 @@ static int maplebus_decode(unsigned char *data, unsigned int maxlen)
 	// Look for the initial phase 1 (Pin 1 high, Pin 5 low). This
 	// is to skip what we got of the sync/start of frame sequence.
 	// 
-	for (i=0; i<MAPLE_BUF_SIZE; i++) {
-		if ((maplebuf[i]&0x03) == 0x01)
+	for (i=0; i<MAPLE_RX_SAMPLES; i++) {
+		if (rx_sample(i) == 0x01)
 			break;
 	}
-	if (i==MAPLE_BUF_SIZE) {
+	if (i==MAPLE_RX_SAMPLES) {
 		return -1; // timeout
 	}
 
 	dst_pos = 0;
-	data[0] = 0;
+	b = 0;
 	dst_b = 0x80;
-	last = maplebuf[i] & 0x03;
+	last = rx_sample(i);
 	last_fell = 0;
-	for (; i<MAPLE_BUF_SIZE; i++) {
+	for (; i<MAPLE_RX_SAMPLES; i++) {
 		unsigned char fell;
-		unsigned char cur = maplebuf[i] & 0x3;
+		unsigned char cur = rx_sample(i);
 
 #ifdef TRACE_PIN1_BITS
 		if (cur & 1) {
@@ -158,7 +388,7 @@ static int maplebus_decode(unsigned char *data, unsigned int maxlen)
 			}
 
 			if (cur) {
-				data[dst_pos] |= dst_b;
+				b |= dst_b;
 #ifdef TRACE_DECODED
 				PORTB |= 0x10;
 #endif
@@ -172,6 +402,13 @@ static int maplebus_decode(unsigned char *data, unsigned int maxlen)
 		
 		dst_b >>= 1;
 		if (!dst_b) {
+			// Store with the 32 bit words byte-swapped. The LRC
+			// usually falls outside the buffer.
+			if ((dst_pos ^ 3) < maxlen) {
+				data[dst_pos ^ 3] = b;
+			}
+			sum ^= b;
+			b = 0;
 			dst_b = 0x80;
 			dst_pos++;
 			if (dst_pos >= maxlen) {
@@ -180,7 +417,6 @@ static int maplebus_decode(unsigned char *data, unsigned int maxlen)
 #endif
 				return -3;
 			}
-			data[dst_pos] = 0;
 		}
 
 		last_fell = fell;
@@ -191,19 +427,29 @@ static int maplebus_decode(unsigned char *data, unsigned int maxlen)
 	PORTB &= ~0x10;
 #endif
 
+	*lrc = sum;
 	return dst_pos;
 }
 
 /**
- * \param data Destination buffer to store reply (payload + crc + eot)
+ * Capture PINC samples in maplebuf, then decode them.
+ *
+ * \param data Destination buffer to store reply (header + payload + crc, words byte-swapped)
  * \param maxlen The length of the destination buffer
- * \return -1 on timeout, -2 lrc/frame error, -3 too much data. Otherwise the number of bytes received
+ * \param lrc Xor of all bytes received, including the crc. Zero when valid.
+ * \return -1 on timeout, -3 too much data. Otherwise the number of bytes received
  */
-int maple_receiveFrame(unsigned char *data, unsigned int maxlen)
+static int maple_receiveRaw(unsigned char *data, unsigned int maxlen, unsigned char *lrc)
 {
-	unsigned char lrc;
 	unsigned char timeout;
-	int res, i;
+	unsigned int stamp;
+	volatile unsigned char *dst = maplebuf;
+
+#ifdef MAPLE_RX_PACKED
+	rx_fix = (PINC & 0x40) ? 0x44 : 0x00;
+#endif
+
+	rx_armStartTimeout();
 
 	//
 	//  __       _   _   _
@@ -215,61 +461,399 @@ int maple_receiveFrame(unsigned char *data, unsigned int maxlen)
 	//
 
 	asm volatile( 
-			"	push r30		\n" // 2
-			"	push r31		\n"	// 2
 			"	clr %0			\n" // 1 (result=0, no timeout)
 			
-			"	ldi r30, lo8(maplebuf)	\n"
-			"	ldi r31, hi8(maplebuf)	\n"
 //			"	sbi 0x5, 4		\n" // PB4
 //			"	cbi 0x5, 4		\n"
 
-			// Loop until a change is detected.	
-			"	ldi r19, 10		\n"
-			"wait_start_outer:	\n"
-			"	dec r19			\n"
-			"	breq timeout	\n"
-			"	ldi r18, 255	\n"
-			"	in r17, %1		\n"
-			"wait_start_inner:		\n"
-			"	dec r18			\n"
-			"	breq wait_start_outer	\n"
-			"	in r16, %1		\n"
-			"	cp r16, r17		\n"
-			"	breq wait_start_inner	\n"
-			"	rjmp start_rx	\n"
-
-"timeout:\n"
+			// Loop until a change is detected, or OCF1B is set.
+			"	in r17, %[pin]		\n"
+			"wait_start%=:		\n"
+			"	sbic %[tifr1], " STR(OCF1B) "	\n" // 2
+			"	rjmp timeout%=	\n"
+			"	in r16, %[pin]		\n" // 1
+			"	cp r16, r17		\n" // 1
+			"	breq wait_start%=	\n" // 2
+			"	rjmp start_rx%=	\n"
+
+"timeout%=:\n"
 			"	inc %0			\n" // 1 for timeout
 			"	sbi 0x5, 4		\n" // PB4
 			"	cbi 0x5, 4		\n"
-			"	jmp done		\n"
+			"	jmp done%=		\n"
 
-"start_rx:			\n"
+"start_rx%=:			\n"
 #ifdef TRACE_RX_START_END
 			"	sbi 0x5, 4		\n" // PB4
 			"	cbi 0x5, 4		\n"
 #endif
 
+			// Timestamp for maple_getLatency()
+			"	lds %A[stamp], %[tcnt1]	\n"
+			"	lds %B[stamp], %[tcnt1]+1	\n"
+
 			// We will loose the first bit(s), but
 			// it's only the start of frame.
+#ifdef MAPLE_RX_PACKED
+			#include "rxcode_packed.asm"
+#else
 			#include "rxcode.asm"			
+#endif
 
-"done:\n"
+"done%=:\n"
 #ifdef TRACE_RX_START_END
 			"	sbi 0x5, 4		\n" // PB4
 			"	cbi 0x5, 4		\n"
 #endif
-			"	pop r31			\n" // 2
-			"	pop r30			\n" // 2
-		: "=r"(timeout)
-		: "I" (_SFR_IO_ADDR(PINC))
-		: "r16","r17","r18","r19") ;
+		: "=r"(timeout), [stamp] "=&r"(stamp), [dst] "+z"(dst)
+		: [pin] "I" (_SFR_IO_ADDR(PINC)),
+		  [tcnt1] "n" (_SFR_MEM_ADDR(TCNT1)),
+		  [tifr1] "I" (_SFR_IO_ADDR(TIFR1))
+		: "r16","r17","r18","r19","r20","r24","r25") ;
+
+	// The generated code must match the settings of this build. If
+	// not, it was generated by an older Makefile: run make clean.
+#ifdef MAPLE_RX_PACKED
+#if RXCODE_PACKED_BYTES != MAPLE_RX_NSAMPLES
+#error rxcode_packed.asm does not match MAPLE_RX_NSAMPLES
+#endif
+#else
+#if RXCODE_NSAMPLES != MAPLE_RX_NSAMPLES || RXCODE_SAMPLE_CYCLES != MAPLE_RX_SAMPLE_CYCLES
+#error rxcode.asm does not match MAPLE_RX_NSAMPLES or MAPLE_RX_SAMPLE_CYCLES
+#endif
+#endif
 
 	if (timeout)
 		return -1;
 
-	res = maplebus_decode(data, maxlen);
+	rx_latency = stamp - tx_end;
+
+	return maplebus_decode(data, maxlen, lrc);
+}
+
+#else // MAPLE_RX_SAMPLED
+
+/* Receive deadline. The loops following the clock edges in
+ * maple_receiveRaw() have no spare cycles for checking a timeout. Instead,
+ * this interrupt (only enabled while receiving) resumes execution at the
+ * address in rx_abort_vec rather than where it was interrupted. There is
+ * one copy of the streaming receiver per port, each stores its own abort
+ * label there (RX_SET_ABORT).
+ */
+static unsigned int rx_abort_vec;
+
+ISR(TIMER1_COMPA_vect, ISR_NAKED)
+{
+	asm volatile(
+		"	pop r16			\n" // drop the return address
+		"	pop r16			\n"
+		"	lds r16, %[vec]	\n"
+		"	push r16		\n"
+		"	lds r16, %[vec]+1	\n"
+		"	push r16		\n"
+		"	reti			\n"
+		:: [vec] "i" (&rx_abort_vec)
+	);
+}
+
+#define RX_SET_ABORT(label)	"	ldi r20, pm_lo8(" label ")	\n" \
+							"	sts %[abortvec], r20	\n" \
+							"	ldi r20, pm_hi8(" label ")	\n" \
+							"	sts %[abortvec]+1, r20	\n"
+
+/**
+ * Optionally send a frame, then decode the reply while it is received,
+ * following the clock edges.
+ *
+ * When sending, the lines are released and the wait for the reply starts
+ * a few cycles after the end of frame sequence, within the same asm block.
+ *
+ * Reception stops as soon as the number of words announced in the
+ * header, and the LRC, are in. Each byte is stored with its 32 bit word
+ * byte-swapped and the LRC is computed as it arrives.
+ *
+ * This is instantiated for each port (the pins are constants in the
+ * code), see maple_transferRaw().
+ *
+ * \param port The port (0 to MAPLE_NUM_PORTS-1), a constant
+ * \param tx Frame to send first (header + payload + crc), or NULL
+ * \param tx_len The length of the frame to send. 0 to only receive.
+ * \param data Destination buffer to store reply (header + payload, without crc)
+ * \param maxlen The length of the destination buffer
+ * \param lrc Xor of all bytes received, including the crc. Zero when valid.
+ * \return -1 on timeout, -2 incomplete frame, -3 too much data. Otherwise the number of bytes received
+ */
+static inline __attribute__((always_inline)) int maple_transferPort(unsigned char port,
+								unsigned char *tx, unsigned int tx_len,
+								unsigned char *data, unsigned int maxlen, unsigned char *lrc)
+{
+	unsigned char *end = data + 4;
+	unsigned char count;
+	unsigned char maxwords;
+	unsigned char timeout;
+	unsigned char complete;
+	unsigned char sum;
+	unsigned int ticks;
+	unsigned int stamp;
+	unsigned int wait_start;
+	unsigned char sreg;
+
+	count = maxlen > 255 ? 255 : maxlen;
+	if (count < 5)
+		return -3;
+	// Payload words that fit after the header, with room for the LRC
+	maxwords = (count - 5) / 4;
+	ticks = US_TO_TICKS(count * MAPLE_RX_US_PER_BYTE + MAPLE_RX_US_SLACK + rx_pause_us);
+
+	// A clock (pin 1 or pin 5) falls at the end of each bit. The
+	// other pin holds the data. Pins are sampled every 4 cycles while
+	// waiting and the data bit comes from the same read where the
+	// clock is seen low.
+	//
+	// Each phase takes 7 cycles when no waiting is needed. There is no
+	// time between bytes, so each byte is stored while the next one
+	// comes in, a few cycles at a time: RX_BYTE takes one instruction
+	// (or two) after each bit, run while the clock of the next bit is
+	// high. 3 cycles at most, what is left of a phase at 20MHz. Bytes
+	// go in r17 and r19 in turn.
+#define RX_RISE_1		"1:	sbis %[pin], %[b1]	\n" /* 2 */ \
+						"	rjmp 1b				\n"
+#define RX_RISE_5		"1:	sbis %[pin], %[b5]	\n" /* 2 */ \
+						"	rjmp 1b				\n"
+#define RX_FALL_1(reg, bit)	"1:	in r16, %[pin]		\n" /* 1 */ \
+						"	sbrc r16, %[b1]		\n" /* 2 */ \
+						"	rjmp 1b				\n" \
+						"	bst r16, %[b5]		\n" /* 1 data on pin 5 */ \
+						"	bld " reg ", " #bit "	\n" /* 1 */
+#define RX_FALL_5(reg, bit)	"1:	in r16, %[pin]		\n" /* 1 */ \
+						"	sbrc r16, %[b5]		\n" /* 2 */ \
+						"	rjmp 1b				\n" \
+						"	bst r16, %[b1]		\n" /* 1 data on pin 1 */ \
+						"	bld " reg ", " #bit "	\n" /* 1 */
+#define RX_BYTE(reg, x7, x6, x5, x4, x3, x2, x1, x0) \
+						RX_FALL_1(reg, 7) RX_RISE_5 x7 RX_FALL_5(reg, 6) RX_RISE_1 x6 \
+						RX_FALL_1(reg, 5) RX_RISE_5 x5 RX_FALL_5(reg, 4) RX_RISE_1 x4 \
+						RX_FALL_1(reg, 3) RX_RISE_5 x3 RX_FALL_5(reg, 2) RX_RISE_1 x2 \
+						RX_FALL_1(reg, 1) RX_RISE_5 x1 RX_FALL_5(reg, 0) RX_RISE_1 x0
+	// The LRC, after the last byte in r19. Not stored.
+#define RX_LRC			RX_BYTE("r17", \
+								"	st -z, r19	\n", /* 2 */ \
+								"	eor %[lrc], r19	\n", /* 1 */ \
+								"", "", "", "", "", "") \
+						"	eor %[lrc], r17		\n" \
+						"	inc %[complete]		\n" \
+						"	rjmp rx_abort%=		\n"
+
+	// Same as rx_armStartTimeout(), the current time goes in %[wstart].
+#define RX_ARM_START	"	lds r20, %[tcnt1]	\n" \
+						"	lds r21, %[tcnt1]+1	\n" \
+						"	movw %[wstart], r20	\n" \
+						"	add r20, %A[sticks]	\n" \
+						"	adc r21, %B[sticks]	\n" \
+						"	sts %[ocr1b]+1, r21	\n" \
+						"	sts %[ocr1b], r20	\n" \
+						"	sbi %[tifr1], " STR(OCF1B) "	\n"
+
+	if (tx_len) {
+		transmitMode();
+	}
+
+	// The deadline needs interrupts, which are still disabled
+	// when dcInit() runs.
+	sreg = SREG;
+	sei();
+
+	asm volatile(
+			"	clr %[timeout]		\n"
+			"	clr %[complete]		\n"
+			"	clr %[lrc]			\n"
+			RX_SET_ABORT("rx_abort%=")
+
+			"	sbiw %[txcount], 0	\n"
+			"	brne 1f				\n"
+			"	rjmp rx_arm%=			\n" // TX_FRAME is out of breq range
+"1:						\n"
+			TX_FRAME
+			// TX_END leaves both lines high, as the pull-ups will.
+			"	cbi %[ddr], %[b1]	\n"
+			"	cbi %[ddr], %[b5]	\n"
+"rx_arm%=:				\n"
+			RX_ARM_START
+
+			// Wait for pin 1 to fall (start of frame), or for OCF1B.
+"rx_wait%=:				\n"
+			"	sbic %[tifr1], " STR(OCF1B) "	\n" // 2
+			"	rjmp rx_timeout%=		\n"
+			"	sbic %[pin], %[b1]	\n" // 1
+			"	rjmp rx_wait%=		\n" // 2
+			"	rjmp rx_start%=		\n"
+
+"rx_timeout%=:			\n"
+			"	inc %[timeout]		\n"
+			"	sbi 0x5, 4		\n" // PB4
+			"	cbi 0x5, 4		\n"
+			"	rjmp rx_done%=		\n"
+
+"rx_start%=:				\n"
+#ifdef TRACE_RX_START_END
+			"	sbi 0x5, 4		\n" // PB4
+			"	cbi 0x5, 4		\n"
+#endif
+			// Arm the deadline during the sync sequence
+			"	lds r20, %[tcnt1]	\n"
+			"	lds r21, %[tcnt1]+1	\n"
+			"	movw %[stamp], r20	\n"
+			"	add r20, %A[ticks]	\n"
+			"	adc r21, %B[ticks]	\n"
+			"	sts %[ocr1a]+1, r21	\n"
+			"	sts %[ocr1a], r20	\n"
+			"	sbi %[tifr1], " STR(OCF1A) "	\n"
+			"	ldi r20, 1<<" STR(OCIE1A) "	\n"
+			"	sts %[timsk1], r20	\n"
+
+			// Pin 1 stays low until the end of the sync sequence, where
+			// it rises for the first phase of the first bit.
+			RX_RISE_1
+
+			// The header comes first, starting with the number of
+			// payload words. Decide how many words to receive a little
+			// at a time in the header bytes.
+			//
+			// The bytes of each word are stored in reverse order
+			// (st -Z), Z pointing after the word to fill.
+			RX_BYTE("r17", "", "", "", "", "", "", "", "")
+			RX_BYTE("r19",
+					"	st -z, r17			\n", // 2
+					"	mov r18, r17		\n", // 1
+					"	eor %[lrc], r17		\n", // 1
+					"	cp %[maxwords], r17	\n", // 1
+					"", "", "", "")
+			RX_BYTE("r17",
+					"	st -z, r19			\n", // 2
+					"	brsh 2f				\n" // 1 (2 when taken)
+					"	mov r18, %[maxwords]	\n" // 1 does not fit. Truncate.
+					"2:						\n",
+					"	eor %[lrc], r19		\n", // 1
+					"", "", "", "", "")
+			RX_BYTE("r19",
+					"	st -z, r17			\n", // 2
+					"	eor %[lrc], r17		\n", // 1
+					"	tst r18				\n", // 1
+					"", "", "", "",
+					"	brne rx_words%=		\n") // 2 (1 when not taken)
+			RX_LRC
+
+"rx_words%=:				\n"
+			RX_BYTE("r17",
+					"	st -z, r19			\n", // 2
+					"	eor %[lrc], r19		\n", // 1
+					"	adiw r30, 8			\n", // 2
+					"", "", "", "", "")
+			RX_BYTE("r19",
+					"	st -z, r17			\n", // 2
+					"	eor %[lrc], r17		\n", // 1
+					"", "", "", "", "", "")
+			RX_BYTE("r17",
+					"	st -z, r19			\n", // 2
+					"	eor %[lrc], r19		\n", // 1
+					"", "", "", "", "", "")
+			RX_BYTE("r19",
+					"	st -z, r17			\n", // 2
+					"	eor %[lrc], r17		\n", // 1
+					"	dec r18				\n", // 1
+					"", "", "", "",
+					"	breq 2f				\n" // 1 (2 when taken)
+					"	rjmp rx_words%=		\n" // 2
+					"2:						\n")
+			RX_LRC
+
+			// Reached after the LRC, or through the deadline
+			// interrupt if the device stops sending.
+"rx_abort%=:		\n"
+			"	sts %[timsk1], __zero_reg__	\n"
+
+"rx_done%=:				\n"
+#ifdef TRACE_RX_START_END
+			"	sbi 0x5, 4		\n" // PB4
+			"	cbi 0x5, 4		\n"
+#endif
+		: [timeout] "=&r"(timeout),
+		  [complete] "=&r"(complete),
+		  [lrc] "=&r"(sum),
+		  [stamp] "=&r"(stamp),
+		  [wstart] "=&r"(wait_start),
+		  [end] "+z"(end),
+		  [txcount] "+w"(tx_len),
+		  [txptr] "+x"(tx)
+		: [pin] "I" (_SFR_IO_ADDR(PINC)),
+		  [maxwords] "r"(maxwords),
+		  [ticks] "r"(ticks),
+		  [tcnt1] "n" (_SFR_MEM_ADDR(TCNT1)),
+		  [ocr1a] "n" (_SFR_MEM_ADDR(OCR1A)),
+		  [ocr1b] "n" (_SFR_MEM_ADDR(OCR1B)),
+		  [timsk1] "n" (_SFR_MEM_ADDR(TIMSK1)),
+		  [tifr1] "I" (_SFR_IO_ADDR(TIFR1)),
+		  [sticks] "r"(rx_start_ticks),
+		  [port] "I" (_SFR_IO_ADDR(PORTC)),
+		  [ddr] "I" (_SFR_IO_ADDR(DDRC)),
+		  [mhz] "n" (F_CPU / 1000000L),
+		  [pad] "n" (TX_PAD),
+		  [levels] "i" (tx_levels),
+		  [abortvec] "i" (&rx_abort_vec),
+		  [b1] "I" (port * 2),
+		  [b5] "I" (port * 2 + 1)
+		: "r16","r17","r18","r19","r20","r21","r22","r23","memory");
+
+	SREG = sreg;
+
+	rx_wait_start = wait_start;
+	if (tx) {
+		tx_end = wait_start;
+	}
+
+	if (timeout)
+		return -1;
+
+	rx_latency = stamp - tx_end;
+	*lrc = sum;
+
+	if (!complete)
+		return -2;
+
+	// data[3] is the number of words announced in the header
+	if (data[3] > maxwords)
+		return -3;
+
+	return 4 + data[3] * 4 + 1;
+}
+
+/**
+ * Dispatch to the copy of the streaming receiver for the selected port.
+ */
+static int maple_transferRaw(unsigned char *tx, unsigned int tx_len,
+								unsigned char *data, unsigned int maxlen, unsigned char *lrc)
+{
+	switch (cur_port)
+	{
+#if MAPLE_NUM_PORTS > 1
+		case 1: return maple_transferPort(1, tx, tx_len, data, maxlen, lrc);
+#endif
+#if MAPLE_NUM_PORTS > 2
+		case 2: return maple_transferPort(2, tx, tx_len, data, maxlen, lrc);
+#endif
+	}
+	return maple_transferPort(0, tx, tx_len, data, maxlen, lrc);
+}
+
+static int maple_receiveRaw(unsigned char *data, unsigned int maxlen, unsigned char *lrc)
+{
+	return maple_transferRaw(NULL, 0, data, maxlen, lrc);
+}
+
+#endif // MAPLE_RX_SAMPLED
+
+static int maple_checkFrame(int res, unsigned char lrc)
+{
 	if (res<=0)
 		return res;
 
@@ -279,299 +863,199 @@ int maple_receiveFrame(unsigned char *data, unsigned int maxlen)
 	}
 
 #ifndef NOLRC
-	for (lrc=0, i=0; i<res; i++) {
-		lrc ^= data[i];
-	}
 	if (lrc)
 		return -2; // LRC error
 #endif
 
-	/* Reverse each group of 4 bytes */
-	for (i=0; i<(res-1); i+=4) {
-		unsigned char tmp;
-
-		tmp = data[i+3];
-		data[i+3] = data[i];
-		data[i] = tmp;
-
-		tmp = data[i+2];
-		data[i+2] = data[i+1];
-		data[i+1] = tmp;
-	}
-
 	return res-1; // remove lrc
 }
 
-static void maple_sendByte(uint8_t data)
-{{{
-	// Phase 1 initial state (pin 1 high, pin 5 low);
-	PORTC = 0x01;
-	_delay_us(1);
-	if (data & 0x80)
-		PORTC |= 0x02;
-	nop();
-	PORTC &= ~0x01;
-	_delay_us(1);
-	
-	// Phase 2 initial state (pin 1 low, pin 5 high;
-	PORTC = 0x02;
-	_delay_us(1);
-	if (data & 0x40)
-		PORTC |= 0x01;
-	nop();
-	PORTC &= ~0x02;
-	_delay_us(1);
-
-	// Phase 1 initial state (pin 1 high, pin 5 low);
-	PORTC = 0x01;
-	_delay_us(1);
-	if (data & 0x20)
-		PORTC |= 0x02;
-	nop();
-	PORTC &= ~0x01;
-	_delay_us(1);
-	
-	// Phase 2 initial state (pin 1 low, pin 5 high;
-	PORTC = 0x02;
-	_delay_us(1);
-	if (data & 0x10)
-		PORTC |= 0x01;
-	nop();
-	PORTC &= ~0x02;
-	_delay_us(1);
-
-	// Phase 1 initial state (pin 1 high, pin 5 low);
-	PORTC = 0x01;
-	_delay_us(1);
-	if (data & 0x08)
-		PORTC |= 0x02;
-	nop();
-	PORTC &= ~0x01;
-	_delay_us(1);
-	
-	// Phase 2 initial state (pin 1 low, pin 5 high;
-	PORTC = 0x02;
-	_delay_us(1);
-	if (data & 0x04)
-		PORTC |= 0x01;
-	nop();
-	PORTC &= ~0x02;
-	_delay_us(1);
-
-	// Phase 1 initial state (pin 1 high, pin 5 low);
-	PORTC = 0x01;
-	_delay_us(1);
-	if (data & 0x02)
-		PORTC |= 0x02;
-	nop();
-	PORTC &= ~0x01;
-	_delay_us(1);
-	
-	// Phase 2 initial state (pin 1 low, pin 5 high;
-	PORTC = 0x02;
-	_delay_us(1);
-	if (data & 0x01)
-		PORTC |= 0x01;
-	nop();
-	PORTC &= ~0x02;
-	_delay_us(1);
-}}}
-
-/* Slower C implementation for sending data from program memory. */
-void maple_sendRaw_P(unsigned char header_data[4], PGM_P data, unsigned char len)
+/**
+ * \param data Destination buffer to store reply (header + payload). Each
+ *             32 bit word is byte-swapped, even when an error is returned.
+ * \param maxlen The length of the destination buffer
+ * \return -1 on timeout, -2 lrc/frame error, -3 too much data. Otherwise the number of bytes received
+ */
+int maple_receiveFrame(unsigned char *data, unsigned int maxlen)
 {
-	int i;
-	uint8_t tmp;
-	uint8_t lrc = 0;
+	unsigned char lrc;
+	int res;
 
-	transmitMode();
+	res = maple_receiveRaw(data, maxlen, &lrc);
 
-	// Initially both lines are high
-	PORTC = 0x03;
-	// Pin 1 falls
-	PORTC = 0x02;
-	_delay_us(1);
-	
-	// Pin 5 falls
-	PORTC = 0x00;
-	_delay_us(1);
-
-	// 3 pulses on pin 5
-	PORTC = 0x02;
-	_delay_us(1);
-	PORTC = 0x00;
-	_delay_us(1);
-	PORTC = 0x02;
-	_delay_us(1);
-	PORTC = 0x00;
-	_delay_us(1);
-	PORTC = 0x02;
-	_delay_us(1);
-	PORTC = 0x00;
-	_delay_us(1);
-
-	PORTC = 0x02;
-	_delay_us(1);
-
-	PORTC = 0x03;
-	_delay_us(1);
-	
-	// Phase 1 initial state (pin 1 high, pin 5 low);
-	PORTC = 0x01;
+	return maple_checkFrame(res, lrc);
+}
 
-	for (i=0; i<4; i++) {
-		maple_sendByte(header_data[i]);
-		lrc ^= header_data[i];
-	}
+/**
+ * Send a complete frame (see maple_buildFrame1W()) and receive the reply.
+ *
+ * With the default receiver, there is no return to C in between. The
+ * sampled receivers send and receive separately.
+ *
+ * \param frame The frame to send (header + payload + crc)
+ * \param len The length of the frame
+ * \param data Destination buffer to store reply, as for maple_receiveFrame()
+ * \param maxlen The length of the destination buffer
+ * \return Same as maple_receiveFrame()
+ */
+int maple_sendReceiveFrame(uint8_t *frame, unsigned int len, uint8_t *data, unsigned int maxlen)
+{
+	unsigned char lrc;
+	int res;
 
-	for (i=0; i<len; i++) {
-		// Swap byte order in each word
-		tmp = pgm_read_byte(data + (i&0xfc) + (3-(i&0x03)));
-		maple_sendByte(tmp);
-		lrc ^= tmp;
-		if (i && (i%8==0)) {
-			_delay_us(30);
-		}
-	}
-	
-	maple_sendByte(lrc);
+#ifdef MAPLE_RX_SAMPLED
+	maple_sendRaw(frame, len);
+	res = maple_receiveRaw(data, maxlen, &lrc);
+#else
+	res = maple_transferRaw(frame, len, data, maxlen, &lrc);
+#endif
 
-	// End of frame initial state (Pin 1 high, pin 5 low)
-	PORTC = 0x01;
-	_delay_us(1);
+	return maple_checkFrame(res, lrc);
+}
 
-	// pulse on pin5
-	PORTC = 0x03;
-	_delay_us(1);
-	PORTC = 0x01;
-	_delay_us(1);
+void maple_sendRaw(unsigned char *data, unsigned int len)
+{
+	unsigned char *ptr = data;
+	unsigned int count = len;
 
-	// pin 1 falls
-	PORTC = 0x00;
-	_delay_us(1);
+	if (!len)
+		return;
 
-	// pin 1 pulse
-	PORTC = 0x01;
-	_delay_us(1);
-	PORTC = 0x00;
-	_delay_us(1);
+	// Output
+	transmitMode();
 
-	// pin 1 rise
-	PORTC = 0x01;
-	_delay_us(1);
+	asm volatile(
+		TX_FRAME
+		: [txcount] "+w"(count),
+		  [txptr] "+x"(ptr)
+		: [port] "I" (_SFR_IO_ADDR(PORTC)),
+		  [mhz] "n" (F_CPU / 1000000L),
+		  [pad] "n" (TX_PAD),
+		  [levels] "i" (tx_levels)
+		: "r16","r17","r18","r19","r20","r21","r22","r23"
+	);
 
-	// pin 5 rise
-	PORTC = 0x03;
+	tx_end = TCNT1;
 
+	// back to input to receive the answer
 	inputMode();
 }
 
-void maple_sendRaw(unsigned char *data, unsigned char len)
+/**
+ * Send a frame with a payload in program memory. Each 32 bit word of the
+ * payload is byte-swapped while sending, and the LRC is appended.
+ *
+ * \param header_data The 4 header bytes, in bus order
+ * \param data The payload, in program memory
+ * \param len Length of the payload. A multiple of 4, at least 4.
+ */
+void maple_sendRaw_P(unsigned char header_data[4], PGM_P data, unsigned int len)
 {
-	int i;
-	unsigned char b;
+	unsigned char *hdr = header_data;
+	PGM_P ptr = data + 3; // last byte of the first word
+	unsigned char words;
+	unsigned char lrc = 0;
+	unsigned int i;
 
-	buf_reset();
-	for (i=0; i<len; i++) {
-		for (b=0x80; b; b>>=1)
-		{
-			buf_addBit(data[i] & b);
-		}
+	// The frame header counts words in one byte
+	if (len < 4 || len / 4 > 255)
+		return;
+	words = len / 4;
+
+	for (i=0; i<4; i++) {
+		lrc ^= header_data[i];
+	}
+	for (i=0; i<words * 4; i++) {
+		lrc ^= pgm_read_byte(data + i);
 	}
 
-	// Output
 	transmitMode();
 
-	// DC controller pin 1 and pin 5
-#define SET_1		"	sbi %0, 0\n"
-#define CLR_1		"	cbi %0, 0\n"
-#define SET_5		"	sbi %0, 1\n"
-#define CLR_5		"	cbi %0, 1\n"
-#define DLY_8		"	nop\nnop\nnop\nnop\nnop\nnop\nnop\nnop\n"
-#define DLY_5		"	nop\nnop\nnop\nnop\nnop\n"
-#define DLY_4		"	nop\nnop\nnop\nnop\n"
-#define DLY_3		"	nop\nnop\nnop\n"
-
+	// Same bit rate as TX_FRAME: every byte takes 64 cycles at 16MHz,
+	// the 8 phases plus 8 cycles of extra instructions (the loop
+	// overhead counts in the last byte of the word). The next byte is
+	// loaded in r18 while the current one (r16) is sent.
 	asm volatile(
-		"push r31\n"
-		"push r30\n"
-
-		"mov r19, %1	\n" // Length in bytes		
-		"ldi r20, 0x01	\n" // phase 1 pin 1 high, pin 5 low
-		"ldi r21, 0x02	\n" // phase 2 pin 1 low, pin 2 high
+		TX_LOAD
+
+		"ld r16, x+		\n"
+
+		TX_SYNC
+
+		// Header, from RAM
+		TX_BYTE(TX_NOP, "	ld r18, x+	\n", TX_NOP, TX_NOP,
+				TX_NOP, TX_NOP, "", "	mov r16, r18	\n")
+		TX_BYTE(TX_NOP, "	ld r18, x+	\n", TX_NOP, TX_NOP,
+				TX_NOP, TX_NOP, "", "	mov r16, r18	\n")
+		TX_BYTE(TX_NOP, "	ld r18, x+	\n", TX_NOP, TX_NOP,
+				TX_NOP, TX_NOP, "", "	mov r16, r18	\n")
+		TX_BYTE(TX_NOP, "	lpm r18, z	\n", "", TX_NOP,
+				"", "", "", "	mov r16, r18	\n")
+		"rjmp tx_p_word%=	\n" // 2
+
+		// Payload, from flash. Z points to the last byte of the word
+		// and moves backwards. The last byte of the next word is
+		// loaded while the first one is sent.
+"tx_p_word%=:\n"
+		TX_BYTE("", "	sbiw r30, 1	\n", "", "	lpm r18, z	\n",
+				"	dec %[words]	\n	in r19, __SREG__	\n", /* 2, see TX_COUNT */
+				"", "", "	mov r16, r18	\n")
+		TX_BYTE(TX_NOP, "	sbiw r30, 1	\n", "", "	lpm r18, z	\n",
+				"", TX_NOP, "", "	mov r16, r18	\n")
+		TX_BYTE("", "	sbiw r30, 1	\n", "", "	lpm r18, z	\n",
+				"", "	adiw r30, 7	\n", "", "	mov r16, r18	\n")
+		TX_BYTE("", TX_NOP, "", "	lpm r18, z	\n",
+				"", "", "", "	mov r16, r18	\n")
+		TX_LOOP("tx_p_word%=") // 3, 2 when done
+
+		// LRC
+		"mov r16, %[lrc]	\n" // 1
+		TX_BYTE(TX_NOP, TX_NOP, TX_NOP, TX_NOP, TX_NOP, TX_NOP, TX_NOP, TX_NOP)
+
+		TX_END
+
+		: [words] "+r"(words),
+		  [hdr] "+x"(hdr),
+		  [ptr] "+z"(ptr)
+		: [port] "I" (_SFR_IO_ADDR(PORTC)),
+		  [lrc] "r"(lrc),
+		  [mhz] "n" (F_CPU / 1000000L),
+		  [pad] "n" (TX_PAD),
+		  [levels] "i" (tx_levels)
+		: "r16","r17","r18","r19","r20","r21","r22","r23"
+	);
 
-		"ld r16, z+		\n"
+	tx_end = TCNT1;
 
-		// Sync
-		SET_1 SET_5 DLY_8 
+	inputMode();
+}
 
-		CLR_1 DLY_4
-		CLR_5 DLY_3
-		
-		SET_5 DLY_3
-		CLR_5
-		DLY_3 
-		SET_5 
-		DLY_3 
-		CLR_5 
-		DLY_3
-		SET_5 
-		DLY_3 
-		CLR_5 DLY_3 SET_5
-		DLY_5 SET_1 CLR_5
-
-		// Pin 5 is low, Pin 1 is high. Ready for 1st phase
-		// Note: Coded for 16Mhz (8 cycles = 500ns)
-"next_byte:\n"
-
-		"out %0, r20	\n" // 1  initial phase 1 state
-//		"nop			\n" // 1
-		"out %0, r16	\n" // 1  data
-		"cbi %0, 0		\n" // 1  falling edge on pin 1
-		"ld r16, z+		\n" // 2  load phase 2 data
-//		"nop			\n" // 1
-		
-		"out %0, r21	\n" // 1  initial phase 2 state
-//		"nop			\n"
-		"out %0, r16	\n" // 1  data
-		"cbi %0, 1		\n" // 1  falling edge on pin 5
-		"ld r16, z+		\n" // 2
-		"dec r19		\n" // 1  Decrement counter for brne below
-		"brne next_byte	\n" // 2
-
-		// End of transmission
-		SET_1
-		DLY_4
-
-		SET_5 CLR_5 DLY_3
-
-		CLR_1 
-		DLY_3 
-		SET_1 
-		DLY_3 
-		CLR_1 
-		DLY_3 
-		SET_1 
-		DLY_3
-		SET_5
-
-		"pop r30		\n"
-		"pop r31		\n"
-
-
-		:
-		: "I" (_SFR_IO_ADDR(PORTC)), "r"(buf_used/2), "z"(maplebuf)
-		: "r1","r16","r17","r18","r19","r20","r21"
-	);
+void maple_buildFrame1W(uint8_t *frame, uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, uint32_t data)
+{
+	uint8_t lrc = 0;
+	int i;
 
-	// back to input to receive the answer
-	inputMode();
+	frame[0] = 1; // one word
+	frame[1] = src_addr;
+	frame[2] = dst_addr;
+	frame[3] = cmd;
+	frame[4] = data;
+	frame[5] = data >> 8;
+	frame[6] = data >> 16;
+	frame[7] = data >> 24;
+
+	for (i=0; i<8; i++) {
+		lrc ^= frame[i];
+	}
+	frame[8] = lrc;
 }
 
 void maple_sendFrame1W(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, uint32_t data)
 {
-	uint8_t tmp[4] = { data, data >> 8, data >> 16, data >> 24 };
-	maple_sendFrame(cmd, dst_addr, src_addr, 4, tmp);
+	uint8_t frame[MAPLE_FRAME1W_SIZE];
+
+	maple_buildFrame1W(frame, cmd, dst_addr, src_addr, data);
+	maple_sendRaw(frame, MAPLE_FRAME1W_SIZE);
 }
 
 void maple_sendFrame_P(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, int data_len, PGM_P data)
@@ -583,6 +1067,11 @@ void maple_sendFrame_P(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, int data
 	header_data[2] = dst_addr;
 	header_data[3] = cmd;
 
+	if (!data_len) {
+		maple_sendFrame(cmd, dst_addr, src_addr, 0, NULL);
+		return;
+	}
+
 	// LRC is generated and sent by the function below.
 	maple_sendRaw_P(header_data, data, data_len);
 }
@@ -11,6 +11,10 @@
 #define MAPLE_CMD_SHUTDOWN_DEV		4
 #define MAPLE_CMD_GET_CONDITION		9
 #define MAPLE_CMD_BLOCK_WRITE		12
+#define MAPLE_CMD_SET_CONDITION		14
+
+/* Reply codes */
+#define MAPLE_RESP_ACK				7
 
 #define MAPLE_FUNC_CONTROLLER	0x001
 #define MAPLE_FUNC_MEMCARD		0x002
@@ -34,13 +38,65 @@
 #define MAPLE_DC_ADDR	0
 #define MAPLE_HEADER(cmd,dst_addr,src_addr,len)	( (((cmd)&0xfful)<<24) | (((dst_addr)&0xfful)<<16) | (((src_addr)&0xfful)<<8) | ((len)&0xff))
 
+/* Number of Maple ports. Pin 1 and pin 5 of each port go to a pair of
+ * PORTC bits: PC0/PC1, PC2/PC3 and PC4/PC5. */
+#ifndef MAPLE_NUM_PORTS
+#define MAPLE_NUM_PORTS	1
+#endif
+
+/* Receiver. MAPLE_RX_SAMPLED (make RX_MODE=sampled) selects the
+ * oversampling receiver (rxcode.asm) which captures raw PINC samples in
+ * maplebuf and decodes them afterwards. Otherwise bits are decoded while
+ * following the clock edges and go straight to the caller's buffer.
+ *
+ * MAPLE_RX_PACKED (make RX_MODE=packed) also packs four samples per byte
+ * (rxcode_packed.asm). Samples are taken every 4 cycles instead of 3,
+ * but the capture lasts 640us instead of 120us.
+ */
+#ifdef MAPLE_RX_PACKED
+#define MAPLE_RX_SAMPLED
+#endif
+
+/* A bit lasts 500ns on the wire (one phase, from a clock fall to the next) */
+#define MAPLE_CYCLES_PER_BIT	(F_CPU / 2000000L)
+
+/* The streaming receiver needs 7 cycles per phase, and 3 more to store the
+ * bytes as they come in: 20MHz. */
+#if MAPLE_CYCLES_PER_BIT < 10
+#define MAPLE_RX_SAMPLED
+#endif
+
 void maple_init(void);
 
+/* Select the port (0 to MAPLE_NUM_PORTS-1) used by the following calls.
+ * Port 0 is selected by maple_init(). */
+void maple_selectPort(unsigned char port);
+
 void maple_sendFrame(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, int data_len, uint8_t *data);
 void maple_sendFrame1W(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, uint32_t data);
+
+/* Build a one word frame (header, data and LRC) for maple_sendRaw(). For
+ * frames sent over and over, such as GET_CONDITION. */
+#define MAPLE_FRAME1W_SIZE	(4 + 4 + 1)
+void maple_buildFrame1W(uint8_t *frame, uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, uint32_t data);
 int maple_receiveFrame(uint8_t *data, unsigned int maxlen);
+int maple_sendReceiveFrame(uint8_t *frame, unsigned int len, uint8_t *data, unsigned int maxlen);
+
+/* Default time allowed for the reply to start, counted from the call to
+ * maple_receiveFrame(). Long enough for the Performance P-20-007. */
+#define MAPLE_START_TIMEOUT_US	900
+
+/* Time allowed for the reply to start, in microseconds. */
+void maple_setStartTimeout(unsigned int us);
+/* Time added to the receive deadline for devices pausing in the middle
+ * of their replies, in microseconds. 0 by default. The oversampling
+ * receiver captures a fixed time and ignores this. */
+void maple_setReplyPause(unsigned int us);
+/* Time between the end of the last frame sent and the start of the
+ * reply, in microseconds. */
+unsigned int maple_getLatency(void);
 
-void maple_sendRaw(uint8_t *data, unsigned char len);
+void maple_sendRaw(uint8_t *data, unsigned int len);
 
 void maple_sendFrame_P(uint8_t cmd, uint8_t dst_addr, uint8_t src_addr, int data_len, PGM_P data);
 
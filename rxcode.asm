@@ -1,643 +0,0 @@
-// Generated by generate_rxcode.sh
-// Number of samples: 640
-"   in r16, %1\n   st z+, r16   \n" // sample 0 
-"   in r16, %1\n   st z+, r16   \n" // sample 1 
-"   in r16, %1\n   st z+, r16   \n" // sample 2 
-"   in r16, %1\n   st z+, r16   \n" // sample 3 
-"   in r16, %1\n   st z+, r16   \n" // sample 4 
-"   in r16, %1\n   st z+, r16   \n" // sample 5 
-"   in r16, %1\n   st z+, r16   \n" // sample 6 
-"   in r16, %1\n   st z+, r16   \n" // sample 7 
-"   in r16, %1\n   st z+, r16   \n" // sample 8 
-"   in r16, %1\n   st z+, r16   \n" // sample 9 
-"   in r16, %1\n   st z+, r16   \n" // sample 10 
-"   in r16, %1\n   st z+, r16   \n" // sample 11 
-"   in r16, %1\n   st z+, r16   \n" // sample 12 
-"   in r16, %1\n   st z+, r16   \n" // sample 13 
-"   in r16, %1\n   st z+, r16   \n" // sample 14 
-"   in r16, %1\n   st z+, r16   \n" // sample 15 
-"   in r16, %1\n   st z+, r16   \n" // sample 16 
-"   in r16, %1\n   st z+, r16   \n" // sample 17 
-"   in r16, %1\n   st z+, r16   \n" // sample 18 
-"   in r16, %1\n   st z+, r16   \n" // sample 19 
-"   in r16, %1\n   st z+, r16   \n" // sample 20 
-"   in r16, %1\n   st z+, r16   \n" // sample 21 
-"   in r16, %1\n   st z+, r16   \n" // sample 22 
-"   in r16, %1\n   st z+, r16   \n" // sample 23 
-"   in r16, %1\n   st z+, r16   \n" // sample 24 
-"   in r16, %1\n   st z+, r16   \n" // sample 25 
-"   in r16, %1\n   st z+, r16   \n" // sample 26 
-"   in r16, %1\n   st z+, r16   \n" // sample 27 
-"   in r16, %1\n   st z+, r16   \n" // sample 28 
-"   in r16, %1\n   st z+, r16   \n" // sample 29 
-"   in r16, %1\n   st z+, r16   \n" // sample 30 
-"   in r16, %1\n   st z+, r16   \n" // sample 31 
-"   in r16, %1\n   st z+, r16   \n" // sample 32 
-"   in r16, %1\n   st z+, r16   \n" // sample 33 
-"   in r16, %1\n   st z+, r16   \n" // sample 34 
-"   in r16, %1\n   st z+, r16   \n" // sample 35 
-"   in r16, %1\n   st z+, r16   \n" // sample 36 
-"   in r16, %1\n   st z+, r16   \n" // sample 37 
-"   in r16, %1\n   st z+, r16   \n" // sample 38 
-"   in r16, %1\n   st z+, r16   \n" // sample 39 
-"   in r16, %1\n   st z+, r16   \n" // sample 40 
-"   in r16, %1\n   st z+, r16   \n" // sample 41 
-"   in r16, %1\n   st z+, r16   \n" // sample 42 
-"   in r16, %1\n   st z+, r16   \n" // sample 43 
-"   in r16, %1\n   st z+, r16   \n" // sample 44 
-"   in r16, %1\n   st z+, r16   \n" // sample 45 
-"   in r16, %1\n   st z+, r16   \n" // sample 46 
-"   in r16, %1\n   st z+, r16   \n" // sample 47 
-"   in r16, %1\n   st z+, r16   \n" // sample 48 
-"   in r16, %1\n   st z+, r16   \n" // sample 49 
-"   in r16, %1\n   st z+, r16   \n" // sample 50 
-"   in r16, %1\n   st z+, r16   \n" // sample 51 
-"   in r16, %1\n   st z+, r16   \n" // sample 52 
-"   in r16, %1\n   st z+, r16   \n" // sample 53 
-"   in r16, %1\n   st z+, r16   \n" // sample 54 
-"   in r16, %1\n   st z+, r16   \n" // sample 55 
-"   in r16, %1\n   st z+, r16   \n" // sample 56 
-"   in r16, %1\n   st z+, r16   \n" // sample 57 
-"   in r16, %1\n   st z+, r16   \n" // sample 58 
-"   in r16, %1\n   st z+, r16   \n" // sample 59 
-"   in r16, %1\n   st z+, r16   \n" // sample 60 
-"   in r16, %1\n   st z+, r16   \n" // sample 61 
-"   in r16, %1\n   st z+, r16   \n" // sample 62 
-"   in r16, %1\n   st z+, r16   \n" // sample 63 
-"   in r16, %1\n   st z+, r16   \n" // sample 64 
-"   in r16, %1\n   st z+, r16   \n" // sample 65 
-"   in r16, %1\n   st z+, r16   \n" // sample 66 
-"   in r16, %1\n   st z+, r16   \n" // sample 67 
-"   in r16, %1\n   st z+, r16   \n" // sample 68 
-"   in r16, %1\n   st z+, r16   \n" // sample 69 
-"   in r16, %1\n   st z+, r16   \n" // sample 70 
-"   in r16, %1\n   st z+, r16   \n" // sample 71 
-"   in r16, %1\n   st z+, r16   \n" // sample 72 
-"   in r16, %1\n   st z+, r16   \n" // sample 73 
-"   in r16, %1\n   st z+, r16   \n" // sample 74 
-"   in r16, %1\n   st z+, r16   \n" // sample 75 
-"   in r16, %1\n   st z+, r16   \n" // sample 76 
-"   in r16, %1\n   st z+, r16   \n" // sample 77 
-"   in r16, %1\n   st z+, r16   \n" // sample 78 
-"   in r16, %1\n   st z+, r16   \n" // sample 79 
-"   in r16, %1\n   st z+, r16   \n" // sample 80 
-"   in r16, %1\n   st z+, r16   \n" // sample 81 
-"   in r16, %1\n   st z+, r16   \n" // sample 82 
-"   in r16, %1\n   st z+, r16   \n" // sample 83 
-"   in r16, %1\n   st z+, r16   \n" // sample 84 
-"   in r16, %1\n   st z+, r16   \n" // sample 85 
-"   in r16, %1\n   st z+, r16   \n" // sample 86 
-"   in r16, %1\n   st z+, r16   \n" // sample 87 
-"   in r16, %1\n   st z+, r16   \n" // sample 88 
-"   in r16, %1\n   st z+, r16   \n" // sample 89 
-"   in r16, %1\n   st z+, r16   \n" // sample 90 
-"   in r16, %1\n   st z+, r16   \n" // sample 91 
-"   in r16, %1\n   st z+, r16   \n" // sample 92 
-"   in r16, %1\n   st z+, r16   \n" // sample 93 
-"   in r16, %1\n   st z+, r16   \n" // sample 94 
-"   in r16, %1\n   st z+, r16   \n" // sample 95 
-"   in r16, %1\n   st z+, r16   \n" // sample 96 
-"   in r16, %1\n   st z+, r16   \n" // sample 97 
-"   in r16, %1\n   st z+, r16   \n" // sample 98 
-"   in r16, %1\n   st z+, r16   \n" // sample 99 
-"   in r16, %1\n   st z+, r16   \n" // sample 100 
-"   in r16, %1\n   st z+, r16   \n" // sample 101 
-"   in r16, %1\n   st z+, r16   \n" // sample 102 
-"   in r16, %1\n   st z+, r16   \n" // sample 103 
-"   in r16, %1\n   st z+, r16   \n" // sample 104 
-"   in r16, %1\n   st z+, r16   \n" // sample 105 
-"   in r16, %1\n   st z+, r16   \n" // sample 106 
-"   in r16, %1\n   st z+, r16   \n" // sample 107 
-"   in r16, %1\n   st z+, r16   \n" // sample 108 
-"   in r16, %1\n   st z+, r16   \n" // sample 109 
-"   in r16, %1\n   st z+, r16   \n" // sample 110 
-"   in r16, %1\n   st z+, r16   \n" // sample 111 
-"   in r16, %1\n   st z+, r16   \n" // sample 112 
-"   in r16, %1\n   st z+, r16   \n" // sample 113 
-"   in r16, %1\n   st z+, r16   \n" // sample 114 
-"   in r16, %1\n   st z+, r16   \n" // sample 115 
-"   in r16, %1\n   st z+, r16   \n" // sample 116 
-"   in r16, %1\n   st z+, r16   \n" // sample 117 
-"   in r16, %1\n   st z+, r16   \n" // sample 118 
-"   in r16, %1\n   st z+, r16   \n" // sample 119 
-"   in r16, %1\n   st z+, r16   \n" // sample 120 
-"   in r16, %1\n   st z+, r16   \n" // sample 121 
-"   in r16, %1\n   st z+, r16   \n" // sample 122 
-"   in r16, %1\n   st z+, r16   \n" // sample 123 
-"   in r16, %1\n   st z+, r16   \n" // sample 124 
-"   in r16, %1\n   st z+, r16   \n" // sample 125 
-"   in r16, %1\n   st z+, r16   \n" // sample 126 
-"   in r16, %1\n   st z+, r16   \n" // sample 127 
-"   in r16, %1\n   st z+, r16   \n" // sample 128 
-"   in r16, %1\n   st z+, r16   \n" // sample 129 
-"   in r16, %1\n   st z+, r16   \n" // sample 130 
-"   in r16, %1\n   st z+, r16   \n" // sample 131 
-"   in r16, %1\n   st z+, r16   \n" // sample 132 
-"   in r16, %1\n   st z+, r16   \n" // sample 133 
-"   in r16, %1\n   st z+, r16   \n" // sample 134 
-"   in r16, %1\n   st z+, r16   \n" // sample 135 
-"   in r16, %1\n   st z+, r16   \n" // sample 136 
-"   in r16, %1\n   st z+, r16   \n" // sample 137 
-"   in r16, %1\n   st z+, r16   \n" // sample 138 
-"   in r16, %1\n   st z+, r16   \n" // sample 139 
-"   in r16, %1\n   st z+, r16   \n" // sample 140 
-"   in r16, %1\n   st z+, r16   \n" // sample 141 
-"   in r16, %1\n   st z+, r16   \n" // sample 142 
-"   in r16, %1\n   st z+, r16   \n" // sample 143 
-"   in r16, %1\n   st z+, r16   \n" // sample 144 
-"   in r16, %1\n   st z+, r16   \n" // sample 145 
-"   in r16, %1\n   st z+, r16   \n" // sample 146 
-"   in r16, %1\n   st z+, r16   \n" // sample 147 
-"   in r16, %1\n   st z+, r16   \n" // sample 148 
-"   in r16, %1\n   st z+, r16   \n" // sample 149 
-"   in r16, %1\n   st z+, r16   \n" // sample 150 
-"   in r16, %1\n   st z+, r16   \n" // sample 151 
-"   in r16, %1\n   st z+, r16   \n" // sample 152 
-"   in r16, %1\n   st z+, r16   \n" // sample 153 
-"   in r16, %1\n   st z+, r16   \n" // sample 154 
-"   in r16, %1\n   st z+, r16   \n" // sample 155 
-"   in r16, %1\n   st z+, r16   \n" // sample 156 
-"   in r16, %1\n   st z+, r16   \n" // sample 157 
-"   in r16, %1\n   st z+, r16   \n" // sample 158 
-"   in r16, %1\n   st z+, r16   \n" // sample 159 
-"   in r16, %1\n   st z+, r16   \n" // sample 160 
-"   in r16, %1\n   st z+, r16   \n" // sample 161 
-"   in r16, %1\n   st z+, r16   \n" // sample 162 
-"   in r16, %1\n   st z+, r16   \n" // sample 163 
-"   in r16, %1\n   st z+, r16   \n" // sample 164 
-"   in r16, %1\n   st z+, r16   \n" // sample 165 
-"   in r16, %1\n   st z+, r16   \n" // sample 166 
-"   in r16, %1\n   st z+, r16   \n" // sample 167 
-"   in r16, %1\n   st z+, r16   \n" // sample 168 
-"   in r16, %1\n   st z+, r16   \n" // sample 169 
-"   in r16, %1\n   st z+, r16   \n" // sample 170 
-"   in r16, %1\n   st z+, r16   \n" // sample 171 
-"   in r16, %1\n   st z+, r16   \n" // sample 172 
-"   in r16, %1\n   st z+, r16   \n" // sample 173 
-"   in r16, %1\n   st z+, r16   \n" // sample 174 
-"   in r16, %1\n   st z+, r16   \n" // sample 175 
-"   in r16, %1\n   st z+, r16   \n" // sample 176 
-"   in r16, %1\n   st z+, r16   \n" // sample 177 
-"   in r16, %1\n   st z+, r16   \n" // sample 178 
-"   in r16, %1\n   st z+, r16   \n" // sample 179 
-"   in r16, %1\n   st z+, r16   \n" // sample 180 
-"   in r16, %1\n   st z+, r16   \n" // sample 181 
-"   in r16, %1\n   st z+, r16   \n" // sample 182 
-"   in r16, %1\n   st z+, r16   \n" // sample 183 
-"   in r16, %1\n   st z+, r16   \n" // sample 184 
-"   in r16, %1\n   st z+, r16   \n" // sample 185 
-"   in r16, %1\n   st z+, r16   \n" // sample 186 
-"   in r16, %1\n   st z+, r16   \n" // sample 187 
-"   in r16, %1\n   st z+, r16   \n" // sample 188 
-"   in r16, %1\n   st z+, r16   \n" // sample 189 
-"   in r16, %1\n   st z+, r16   \n" // sample 190 
-"   in r16, %1\n   st z+, r16   \n" // sample 191 
-"   in r16, %1\n   st z+, r16   \n" // sample 192 
-"   in r16, %1\n   st z+, r16   \n" // sample 193 
-"   in r16, %1\n   st z+, r16   \n" // sample 194 
-"   in r16, %1\n   st z+, r16   \n" // sample 195 
-"   in r16, %1\n   st z+, r16   \n" // sample 196 
-"   in r16, %1\n   st z+, r16   \n" // sample 197 
-"   in r16, %1\n   st z+, r16   \n" // sample 198 
-"   in r16, %1\n   st z+, r16   \n" // sample 199 
-"   in r16, %1\n   st z+, r16   \n" // sample 200 
-"   in r16, %1\n   st z+, r16   \n" // sample 201 
-"   in r16, %1\n   st z+, r16   \n" // sample 202 
-"   in r16, %1\n   st z+, r16   \n" // sample 203 
-"   in r16, %1\n   st z+, r16   \n" // sample 204 
-"   in r16, %1\n   st z+, r16   \n" // sample 205 
-"   in r16, %1\n   st z+, r16   \n" // sample 206 
-"   in r16, %1\n   st z+, r16   \n" // sample 207 
-"   in r16, %1\n   st z+, r16   \n" // sample 208 
-"   in r16, %1\n   st z+, r16   \n" // sample 209 
-"   in r16, %1\n   st z+, r16   \n" // sample 210 
-"   in r16, %1\n   st z+, r16   \n" // sample 211 
-"   in r16, %1\n   st z+, r16   \n" // sample 212 
-"   in r16, %1\n   st z+, r16   \n" // sample 213 
-"   in r16, %1\n   st z+, r16   \n" // sample 214 
-"   in r16, %1\n   st z+, r16   \n" // sample 215 
-"   in r16, %1\n   st z+, r16   \n" // sample 216 
-"   in r16, %1\n   st z+, r16   \n" // sample 217 
-"   in r16, %1\n   st z+, r16   \n" // sample 218 
-"   in r16, %1\n   st z+, r16   \n" // sample 219 
-"   in r16, %1\n   st z+, r16   \n" // sample 220 
-"   in r16, %1\n   st z+, r16   \n" // sample 221 
-"   in r16, %1\n   st z+, r16   \n" // sample 222 
-"   in r16, %1\n   st z+, r16   \n" // sample 223 
-"   in r16, %1\n   st z+, r16   \n" // sample 224 
-"   in r16, %1\n   st z+, r16   \n" // sample 225 
-"   in r16, %1\n   st z+, r16   \n" // sample 226 
-"   in r16, %1\n   st z+, r16   \n" // sample 227 
-"   in r16, %1\n   st z+, r16   \n" // sample 228 
-"   in r16, %1\n   st z+, r16   \n" // sample 229 
-"   in r16, %1\n   st z+, r16   \n" // sample 230 
-"   in r16, %1\n   st z+, r16   \n" // sample 231 
-"   in r16, %1\n   st z+, r16   \n" // sample 232 
-"   in r16, %1\n   st z+, r16   \n" // sample 233 
-"   in r16, %1\n   st z+, r16   \n" // sample 234 
-"   in r16, %1\n   st z+, r16   \n" // sample 235 
-"   in r16, %1\n   st z+, r16   \n" // sample 236 
-"   in r16, %1\n   st z+, r16   \n" // sample 237 
-"   in r16, %1\n   st z+, r16   \n" // sample 238 
-"   in r16, %1\n   st z+, r16   \n" // sample 239 
-"   in r16, %1\n   st z+, r16   \n" // sample 240 
-"   in r16, %1\n   st z+, r16   \n" // sample 241 
-"   in r16, %1\n   st z+, r16   \n" // sample 242 
-"   in r16, %1\n   st z+, r16   \n" // sample 243 
-"   in r16, %1\n   st z+, r16   \n" // sample 244 
-"   in r16, %1\n   st z+, r16   \n" // sample 245 
-"   in r16, %1\n   st z+, r16   \n" // sample 246 
-"   in r16, %1\n   st z+, r16   \n" // sample 247 
-"   in r16, %1\n   st z+, r16   \n" // sample 248 
-"   in r16, %1\n   st z+, r16   \n" // sample 249 
-"   in r16, %1\n   st z+, r16   \n" // sample 250 
-"   in r16, %1\n   st z+, r16   \n" // sample 251 
-"   in r16, %1\n   st z+, r16   \n" // sample 252 
-"   in r16, %1\n   st z+, r16   \n" // sample 253 
-"   in r16, %1\n   st z+, r16   \n" // sample 254 
-"   in r16, %1\n   st z+, r16   \n" // sample 255 
-"   in r16, %1\n   st z+, r16   \n" // sample 256 
-"   in r16, %1\n   st z+, r16   \n" // sample 257 
-"   in r16, %1\n   st z+, r16   \n" // sample 258 
-"   in r16, %1\n   st z+, r16   \n" // sample 259 
-"   in r16, %1\n   st z+, r16   \n" // sample 260 
-"   in r16, %1\n   st z+, r16   \n" // sample 261 
-"   in r16, %1\n   st z+, r16   \n" // sample 262 
-"   in r16, %1\n   st z+, r16   \n" // sample 263 
-"   in r16, %1\n   st z+, r16   \n" // sample 264 
-"   in r16, %1\n   st z+, r16   \n" // sample 265 
-"   in r16, %1\n   st z+, r16   \n" // sample 266 
-"   in r16, %1\n   st z+, r16   \n" // sample 267 
-"   in r16, %1\n   st z+, r16   \n" // sample 268 
-"   in r16, %1\n   st z+, r16   \n" // sample 269 
-"   in r16, %1\n   st z+, r16   \n" // sample 270 
-"   in r16, %1\n   st z+, r16   \n" // sample 271 
-"   in r16, %1\n   st z+, r16   \n" // sample 272 
-"   in r16, %1\n   st z+, r16   \n" // sample 273 
-"   in r16, %1\n   st z+, r16   \n" // sample 274 
-"   in r16, %1\n   st z+, r16   \n" // sample 275 
-"   in r16, %1\n   st z+, r16   \n" // sample 276 
-"   in r16, %1\n   st z+, r16   \n" // sample 277 
-"   in r16, %1\n   st z+, r16   \n" // sample 278 
-"   in r16, %1\n   st z+, r16   \n" // sample 279 
-"   in r16, %1\n   st z+, r16   \n" // sample 280 
-"   in r16, %1\n   st z+, r16   \n" // sample 281 
-"   in r16, %1\n   st z+, r16   \n" // sample 282 
-"   in r16, %1\n   st z+, r16   \n" // sample 283 
-"   in r16, %1\n   st z+, r16   \n" // sample 284 
-"   in r16, %1\n   st z+, r16   \n" // sample 285 
-"   in r16, %1\n   st z+, r16   \n" // sample 286 
-"   in r16, %1\n   st z+, r16   \n" // sample 287 
-"   in r16, %1\n   st z+, r16   \n" // sample 288 
-"   in r16, %1\n   st z+, r16   \n" // sample 289 
-"   in r16, %1\n   st z+, r16   \n" // sample 290 
-"   in r16, %1\n   st z+, r16   \n" // sample 291 
-"   in r16, %1\n   st z+, r16   \n" // sample 292 
-"   in r16, %1\n   st z+, r16   \n" // sample 293 
-"   in r16, %1\n   st z+, r16   \n" // sample 294 
-"   in r16, %1\n   st z+, r16   \n" // sample 295 
-"   in r16, %1\n   st z+, r16   \n" // sample 296 
-"   in r16, %1\n   st z+, r16   \n" // sample 297 
-"   in r16, %1\n   st z+, r16   \n" // sample 298 
-"   in r16, %1\n   st z+, r16   \n" // sample 299 
-"   in r16, %1\n   st z+, r16   \n" // sample 300 
-"   in r16, %1\n   st z+, r16   \n" // sample 301 
-"   in r16, %1\n   st z+, r16   \n" // sample 302 
-"   in r16, %1\n   st z+, r16   \n" // sample 303 
-"   in r16, %1\n   st z+, r16   \n" // sample 304 
-"   in r16, %1\n   st z+, r16   \n" // sample 305 
-"   in r16, %1\n   st z+, r16   \n" // sample 306 
-"   in r16, %1\n   st z+, r16   \n" // sample 307 
-"   in r16, %1\n   st z+, r16   \n" // sample 308 
-"   in r16, %1\n   st z+, r16   \n" // sample 309 
-"   in r16, %1\n   st z+, r16   \n" // sample 310 
-"   in r16, %1\n   st z+, r16   \n" // sample 311 
-"   in r16, %1\n   st z+, r16   \n" // sample 312 
-"   in r16, %1\n   st z+, r16   \n" // sample 313 
-"   in r16, %1\n   st z+, r16   \n" // sample 314 
-"   in r16, %1\n   st z+, r16   \n" // sample 315 
-"   in r16, %1\n   st z+, r16   \n" // sample 316 
-"   in r16, %1\n   st z+, r16   \n" // sample 317 
-"   in r16, %1\n   st z+, r16   \n" // sample 318 
-"   in r16, %1\n   st z+, r16   \n" // sample 319 
-"   in r16, %1\n   st z+, r16   \n" // sample 320 
-"   in r16, %1\n   st z+, r16   \n" // sample 321 
-"   in r16, %1\n   st z+, r16   \n" // sample 322 
-"   in r16, %1\n   st z+, r16   \n" // sample 323 
-"   in r16, %1\n   st z+, r16   \n" // sample 324 
-"   in r16, %1\n   st z+, r16   \n" // sample 325 
-"   in r16, %1\n   st z+, r16   \n" // sample 326 
-"   in r16, %1\n   st z+, r16   \n" // sample 327 
-"   in r16, %1\n   st z+, r16   \n" // sample 328 
-"   in r16, %1\n   st z+, r16   \n" // sample 329 
-"   in r16, %1\n   st z+, r16   \n" // sample 330 
-"   in r16, %1\n   st z+, r16   \n" // sample 331 
-"   in r16, %1\n   st z+, r16   \n" // sample 332 
-"   in r16, %1\n   st z+, r16   \n" // sample 333 
-"   in r16, %1\n   st z+, r16   \n" // sample 334 
-"   in r16, %1\n   st z+, r16   \n" // sample 335 
-"   in r16, %1\n   st z+, r16   \n" // sample 336 
-"   in r16, %1\n   st z+, r16   \n" // sample 337 
-"   in r16, %1\n   st z+, r16   \n" // sample 338 
-"   in r16, %1\n   st z+, r16   \n" // sample 339 
-"   in r16, %1\n   st z+, r16   \n" // sample 340 
-"   in r16, %1\n   st z+, r16   \n" // sample 341 
-"   in r16, %1\n   st z+, r16   \n" // sample 342 
-"   in r16, %1\n   st z+, r16   \n" // sample 343 
-"   in r16, %1\n   st z+, r16   \n" // sample 344 
-"   in r16, %1\n   st z+, r16   \n" // sample 345 
-"   in r16, %1\n   st z+, r16   \n" // sample 346 
-"   in r16, %1\n   st z+, r16   \n" // sample 347 
-"   in r16, %1\n   st z+, r16   \n" // sample 348 
-"   in r16, %1\n   st z+, r16   \n" // sample 349 
-"   in r16, %1\n   st z+, r16   \n" // sample 350 
-"   in r16, %1\n   st z+, r16   \n" // sample 351 
-"   in r16, %1\n   st z+, r16   \n" // sample 352 
-"   in r16, %1\n   st z+, r16   \n" // sample 353 
-"   in r16, %1\n   st z+, r16   \n" // sample 354 
-"   in r16, %1\n   st z+, r16   \n" // sample 355 
-"   in r16, %1\n   st z+, r16   \n" // sample 356 
-"   in r16, %1\n   st z+, r16   \n" // sample 357 
-"   in r16, %1\n   st z+, r16   \n" // sample 358 
-"   in r16, %1\n   st z+, r16   \n" // sample 359 
-"   in r16, %1\n   st z+, r16   \n" // sample 360 
-"   in r16, %1\n   st z+, r16   \n" // sample 361 
-"   in r16, %1\n   st z+, r16   \n" // sample 362 
-"   in r16, %1\n   st z+, r16   \n" // sample 363 
-"   in r16, %1\n   st z+, r16   \n" // sample 364 
-"   in r16, %1\n   st z+, r16   \n" // sample 365 
-"   in r16, %1\n   st z+, r16   \n" // sample 366 
-"   in r16, %1\n   st z+, r16   \n" // sample 367 
-"   in r16, %1\n   st z+, r16   \n" // sample 368 
-"   in r16, %1\n   st z+, r16   \n" // sample 369 
-"   in r16, %1\n   st z+, r16   \n" // sample 370 
-"   in r16, %1\n   st z+, r16   \n" // sample 371 
-"   in r16, %1\n   st z+, r16   \n" // sample 372 
-"   in r16, %1\n   st z+, r16   \n" // sample 373 
-"   in r16, %1\n   st z+, r16   \n" // sample 374 
-"   in r16, %1\n   st z+, r16   \n" // sample 375 
-"   in r16, %1\n   st z+, r16   \n" // sample 376 
-"   in r16, %1\n   st z+, r16   \n" // sample 377 
-"   in r16, %1\n   st z+, r16   \n" // sample 378 
-"   in r16, %1\n   st z+, r16   \n" // sample 379 
-"   in r16, %1\n   st z+, r16   \n" // sample 380 
-"   in r16, %1\n   st z+, r16   \n" // sample 381 
-"   in r16, %1\n   st z+, r16   \n" // sample 382 
-"   in r16, %1\n   st z+, r16   \n" // sample 383 
-"   in r16, %1\n   st z+, r16   \n" // sample 384 
-"   in r16, %1\n   st z+, r16   \n" // sample 385 
-"   in r16, %1\n   st z+, r16   \n" // sample 386 
-"   in r16, %1\n   st z+, r16   \n" // sample 387 
-"   in r16, %1\n   st z+, r16   \n" // sample 388 
-"   in r16, %1\n   st z+, r16   \n" // sample 389 
-"   in r16, %1\n   st z+, r16   \n" // sample 390 
-"   in r16, %1\n   st z+, r16   \n" // sample 391 
-"   in r16, %1\n   st z+, r16   \n" // sample 392 
-"   in r16, %1\n   st z+, r16   \n" // sample 393 
-"   in r16, %1\n   st z+, r16   \n" // sample 394 
-"   in r16, %1\n   st z+, r16   \n" // sample 395 
-"   in r16, %1\n   st z+, r16   \n" // sample 396 
-"   in r16, %1\n   st z+, r16   \n" // sample 397 
-"   in r16, %1\n   st z+, r16   \n" // sample 398 
-"   in r16, %1\n   st z+, r16   \n" // sample 399 
-"   in r16, %1\n   st z+, r16   \n" // sample 400 
-"   in r16, %1\n   st z+, r16   \n" // sample 401 
-"   in r16, %1\n   st z+, r16   \n" // sample 402 
-"   in r16, %1\n   st z+, r16   \n" // sample 403 
-"   in r16, %1\n   st z+, r16   \n" // sample 404 
-"   in r16, %1\n   st z+, r16   \n" // sample 405 
-"   in r16, %1\n   st z+, r16   \n" // sample 406 
-"   in r16, %1\n   st z+, r16   \n" // sample 407 
-"   in r16, %1\n   st z+, r16   \n" // sample 408 
-"   in r16, %1\n   st z+, r16   \n" // sample 409 
-"   in r16, %1\n   st z+, r16   \n" // sample 410 
-"   in r16, %1\n   st z+, r16   \n" // sample 411 
-"   in r16, %1\n   st z+, r16   \n" // sample 412 
-"   in r16, %1\n   st z+, r16   \n" // sample 413 
-"   in r16, %1\n   st z+, r16   \n" // sample 414 
-"   in r16, %1\n   st z+, r16   \n" // sample 415 
-"   in r16, %1\n   st z+, r16   \n" // sample 416 
-"   in r16, %1\n   st z+, r16   \n" // sample 417 
-"   in r16, %1\n   st z+, r16   \n" // sample 418 
-"   in r16, %1\n   st z+, r16   \n" // sample 419 
-"   in r16, %1\n   st z+, r16   \n" // sample 420 
-"   in r16, %1\n   st z+, r16   \n" // sample 421 
-"   in r16, %1\n   st z+, r16   \n" // sample 422 
-"   in r16, %1\n   st z+, r16   \n" // sample 423 
-"   in r16, %1\n   st z+, r16   \n" // sample 424 
-"   in r16, %1\n   st z+, r16   \n" // sample 425 
-"   in r16, %1\n   st z+, r16   \n" // sample 426 
-"   in r16, %1\n   st z+, r16   \n" // sample 427 
-"   in r16, %1\n   st z+, r16   \n" // sample 428 
-"   in r16, %1\n   st z+, r16   \n" // sample 429 
-"   in r16, %1\n   st z+, r16   \n" // sample 430 
-"   in r16, %1\n   st z+, r16   \n" // sample 431 
-"   in r16, %1\n   st z+, r16   \n" // sample 432 
-"   in r16, %1\n   st z+, r16   \n" // sample 433 
-"   in r16, %1\n   st z+, r16   \n" // sample 434 
-"   in r16, %1\n   st z+, r16   \n" // sample 435 
-"   in r16, %1\n   st z+, r16   \n" // sample 436 
-"   in r16, %1\n   st z+, r16   \n" // sample 437 
-"   in r16, %1\n   st z+, r16   \n" // sample 438 
-"   in r16, %1\n   st z+, r16   \n" // sample 439 
-"   in r16, %1\n   st z+, r16   \n" // sample 440 
-"   in r16, %1\n   st z+, r16   \n" // sample 441 
-"   in r16, %1\n   st z+, r16   \n" // sample 442 
-"   in r16, %1\n   st z+, r16   \n" // sample 443 
-"   in r16, %1\n   st z+, r16   \n" // sample 444 
-"   in r16, %1\n   st z+, r16   \n" // sample 445 
-"   in r16, %1\n   st z+, r16   \n" // sample 446 
-"   in r16, %1\n   st z+, r16   \n" // sample 447 
-"   in r16, %1\n   st z+, r16   \n" // sample 448 
-"   in r16, %1\n   st z+, r16   \n" // sample 449 
-"   in r16, %1\n   st z+, r16   \n" // sample 450 
-"   in r16, %1\n   st z+, r16   \n" // sample 451 
-"   in r16, %1\n   st z+, r16   \n" // sample 452 
-"   in r16, %1\n   st z+, r16   \n" // sample 453 
-"   in r16, %1\n   st z+, r16   \n" // sample 454 
-"   in r16, %1\n   st z+, r16   \n" // sample 455 
-"   in r16, %1\n   st z+, r16   \n" // sample 456 
-"   in r16, %1\n   st z+, r16   \n" // sample 457 
-"   in r16, %1\n   st z+, r16   \n" // sample 458 
-"   in r16, %1\n   st z+, r16   \n" // sample 459 
-"   in r16, %1\n   st z+, r16   \n" // sample 460 
-"   in r16, %1\n   st z+, r16   \n" // sample 461 
-"   in r16, %1\n   st z+, r16   \n" // sample 462 
-"   in r16, %1\n   st z+, r16   \n" // sample 463 
-"   in r16, %1\n   st z+, r16   \n" // sample 464 
-"   in r16, %1\n   st z+, r16   \n" // sample 465 
-"   in r16, %1\n   st z+, r16   \n" // sample 466 
-"   in r16, %1\n   st z+, r16   \n" // sample 467 
-"   in r16, %1\n   st z+, r16   \n" // sample 468 
-"   in r16, %1\n   st z+, r16   \n" // sample 469 
-"   in r16, %1\n   st z+, r16   \n" // sample 470 
-"   in r16, %1\n   st z+, r16   \n" // sample 471 
-"   in r16, %1\n   st z+, r16   \n" // sample 472 
-"   in r16, %1\n   st z+, r16   \n" // sample 473 
-"   in r16, %1\n   st z+, r16   \n" // sample 474 
-"   in r16, %1\n   st z+, r16   \n" // sample 475 
-"   in r16, %1\n   st z+, r16   \n" // sample 476 
-"   in r16, %1\n   st z+, r16   \n" // sample 477 
-"   in r16, %1\n   st z+, r16   \n" // sample 478 
-"   in r16, %1\n   st z+, r16   \n" // sample 479 
-"   in r16, %1\n   st z+, r16   \n" // sample 480 
-"   in r16, %1\n   st z+, r16   \n" // sample 481 
-"   in r16, %1\n   st z+, r16   \n" // sample 482 
-"   in r16, %1\n   st z+, r16   \n" // sample 483 
-"   in r16, %1\n   st z+, r16   \n" // sample 484 
-"   in r16, %1\n   st z+, r16   \n" // sample 485 
-"   in r16, %1\n   st z+, r16   \n" // sample 486 
-"   in r16, %1\n   st z+, r16   \n" // sample 487 
-"   in r16, %1\n   st z+, r16   \n" // sample 488 
-"   in r16, %1\n   st z+, r16   \n" // sample 489 
-"   in r16, %1\n   st z+, r16   \n" // sample 490 
-"   in r16, %1\n   st z+, r16   \n" // sample 491 
-"   in r16, %1\n   st z+, r16   \n" // sample 492 
-"   in r16, %1\n   st z+, r16   \n" // sample 493 
-"   in r16, %1\n   st z+, r16   \n" // sample 494 
-"   in r16, %1\n   st z+, r16   \n" // sample 495 
-"   in r16, %1\n   st z+, r16   \n" // sample 496 
-"   in r16, %1\n   st z+, r16   \n" // sample 497 
-"   in r16, %1\n   st z+, r16   \n" // sample 498 
-"   in r16, %1\n   st z+, r16   \n" // sample 499 
-"   in r16, %1\n   st z+, r16   \n" // sample 500 
-"   in r16, %1\n   st z+, r16   \n" // sample 501 
-"   in r16, %1\n   st z+, r16   \n" // sample 502 
-"   in r16, %1\n   st z+, r16   \n" // sample 503 
-"   in r16, %1\n   st z+, r16   \n" // sample 504 
-"   in r16, %1\n   st z+, r16   \n" // sample 505 
-"   in r16, %1\n   st z+, r16   \n" // sample 506 
-"   in r16, %1\n   st z+, r16   \n" // sample 507 
-"   in r16, %1\n   st z+, r16   \n" // sample 508 
-"   in r16, %1\n   st z+, r16   \n" // sample 509 
-"   in r16, %1\n   st z+, r16   \n" // sample 510 
-"   in r16, %1\n   st z+, r16   \n" // sample 511 
-"   in r16, %1\n   st z+, r16   \n" // sample 512 
-"   in r16, %1\n   st z+, r16   \n" // sample 513 
-"   in r16, %1\n   st z+, r16   \n" // sample 514 
-"   in r16, %1\n   st z+, r16   \n" // sample 515 
-"   in r16, %1\n   st z+, r16   \n" // sample 516 
-"   in r16, %1\n   st z+, r16   \n" // sample 517 
-"   in r16, %1\n   st z+, r16   \n" // sample 518 
-"   in r16, %1\n   st z+, r16   \n" // sample 519 
-"   in r16, %1\n   st z+, r16   \n" // sample 520 
-"   in r16, %1\n   st z+, r16   \n" // sample 521 
-"   in r16, %1\n   st z+, r16   \n" // sample 522 
-"   in r16, %1\n   st z+, r16   \n" // sample 523 
-"   in r16, %1\n   st z+, r16   \n" // sample 524 
-"   in r16, %1\n   st z+, r16   \n" // sample 525 
-"   in r16, %1\n   st z+, r16   \n" // sample 526 
-"   in r16, %1\n   st z+, r16   \n" // sample 527 
-"   in r16, %1\n   st z+, r16   \n" // sample 528 
-"   in r16, %1\n   st z+, r16   \n" // sample 529 
-"   in r16, %1\n   st z+, r16   \n" // sample 530 
-"   in r16, %1\n   st z+, r16   \n" // sample 531 
-"   in r16, %1\n   st z+, r16   \n" // sample 532 
-"   in r16, %1\n   st z+, r16   \n" // sample 533 
-"   in r16, %1\n   st z+, r16   \n" // sample 534 
-"   in r16, %1\n   st z+, r16   \n" // sample 535 
-"   in r16, %1\n   st z+, r16   \n" // sample 536 
-"   in r16, %1\n   st z+, r16   \n" // sample 537 
-"   in r16, %1\n   st z+, r16   \n" // sample 538 
-"   in r16, %1\n   st z+, r16   \n" // sample 539 
-"   in r16, %1\n   st z+, r16   \n" // sample 540 
-"   in r16, %1\n   st z+, r16   \n" // sample 541 
-"   in r16, %1\n   st z+, r16   \n" // sample 542 
-"   in r16, %1\n   st z+, r16   \n" // sample 543 
-"   in r16, %1\n   st z+, r16   \n" // sample 544 
-"   in r16, %1\n   st z+, r16   \n" // sample 545 
-"   in r16, %1\n   st z+, r16   \n" // sample 546 
-"   in r16, %1\n   st z+, r16   \n" // sample 547 
-"   in r16, %1\n   st z+, r16   \n" // sample 548 
-"   in r16, %1\n   st z+, r16   \n" // sample 549 
-"   in r16, %1\n   st z+, r16   \n" // sample 550 
-"   in r16, %1\n   st z+, r16   \n" // sample 551 
-"   in r16, %1\n   st z+, r16   \n" // sample 552 
-"   in r16, %1\n   st z+, r16   \n" // sample 553 
-"   in r16, %1\n   st z+, r16   \n" // sample 554 
-"   in r16, %1\n   st z+, r16   \n" // sample 555 
-"   in r16, %1\n   st z+, r16   \n" // sample 556 
-"   in r16, %1\n   st z+, r16   \n" // sample 557 
-"   in r16, %1\n   st z+, r16   \n" // sample 558 
-"   in r16, %1\n   st z+, r16   \n" // sample 559 
-"   in r16, %1\n   st z+, r16   \n" // sample 560 
-"   in r16, %1\n   st z+, r16   \n" // sample 561 
-"   in r16, %1\n   st z+, r16   \n" // sample 562 
-"   in r16, %1\n   st z+, r16   \n" // sample 563 
-"   in r16, %1\n   st z+, r16   \n" // sample 564 
-"   in r16, %1\n   st z+, r16   \n" // sample 565 
-"   in r16, %1\n   st z+, r16   \n" // sample 566 
-"   in r16, %1\n   st z+, r16   \n" // sample 567 
-"   in r16, %1\n   st z+, r16   \n" // sample 568 
-"   in r16, %1\n   st z+, r16   \n" // sample 569 
-"   in r16, %1\n   st z+, r16   \n" // sample 570 
-"   in r16, %1\n   st z+, r16   \n" // sample 571 
-"   in r16, %1\n   st z+, r16   \n" // sample 572 
-"   in r16, %1\n   st z+, r16   \n" // sample 573 
-"   in r16, %1\n   st z+, r16   \n" // sample 574 
-"   in r16, %1\n   st z+, r16   \n" // sample 575 
-"   in r16, %1\n   st z+, r16   \n" // sample 576 
-"   in r16, %1\n   st z+, r16   \n" // sample 577 
-"   in r16, %1\n   st z+, r16   \n" // sample 578 
-"   in r16, %1\n   st z+, r16   \n" // sample 579 
-"   in r16, %1\n   st z+, r16   \n" // sample 580 
-"   in r16, %1\n   st z+, r16   \n" // sample 581 
-"   in r16, %1\n   st z+, r16   \n" // sample 582 
-"   in r16, %1\n   st z+, r16   \n" // sample 583 
-"   in r16, %1\n   st z+, r16   \n" // sample 584 
-"   in r16, %1\n   st z+, r16   \n" // sample 585 
-"   in r16, %1\n   st z+, r16   \n" // sample 586 
-"   in r16, %1\n   st z+, r16   \n" // sample 587 
-"   in r16, %1\n   st z+, r16   \n" // sample 588 
-"   in r16, %1\n   st z+, r16   \n" // sample 589 
-"   in r16, %1\n   st z+, r16   \n" // sample 590 
-"   in r16, %1\n   st z+, r16   \n" // sample 591 
-"   in r16, %1\n   st z+, r16   \n" // sample 592 
-"   in r16, %1\n   st z+, r16   \n" // sample 593 
-"   in r16, %1\n   st z+, r16   \n" // sample 594 
-"   in r16, %1\n   st z+, r16   \n" // sample 595 
-"   in r16, %1\n   st z+, r16   \n" // sample 596 
-"   in r16, %1\n   st z+, r16   \n" // sample 597 
-"   in r16, %1\n   st z+, r16   \n" // sample 598 
-"   in r16, %1\n   st z+, r16   \n" // sample 599 
-"   in r16, %1\n   st z+, r16   \n" // sample 600 
-"   in r16, %1\n   st z+, r16   \n" // sample 601 
-"   in r16, %1\n   st z+, r16   \n" // sample 602 
-"   in r16, %1\n   st z+, r16   \n" // sample 603 
-"   in r16, %1\n   st z+, r16   \n" // sample 604 
-"   in r16, %1\n   st z+, r16   \n" // sample 605 
-"   in r16, %1\n   st z+, r16   \n" // sample 606 
-"   in r16, %1\n   st z+, r16   \n" // sample 607 
-"   in r16, %1\n   st z+, r16   \n" // sample 608 
-"   in r16, %1\n   st z+, r16   \n" // sample 609 
-"   in r16, %1\n   st z+, r16   \n" // sample 610 
-"   in r16, %1\n   st z+, r16   \n" // sample 611 
-"   in r16, %1\n   st z+, r16   \n" // sample 612 
-"   in r16, %1\n   st z+, r16   \n" // sample 613 
-"   in r16, %1\n   st z+, r16   \n" // sample 614 
-"   in r16, %1\n   st z+, r16   \n" // sample 615 
-"   in r16, %1\n   st z+, r16   \n" // sample 616 
-"   in r16, %1\n   st z+, r16   \n" // sample 617 
-"   in r16, %1\n   st z+, r16   \n" // sample 618 
-"   in r16, %1\n   st z+, r16   \n" // sample 619 
-"   in r16, %1\n   st z+, r16   \n" // sample 620 
-"   in r16, %1\n   st z+, r16   \n" // sample 621 
-"   in r16, %1\n   st z+, r16   \n" // sample 622 
-"   in r16, %1\n   st z+, r16   \n" // sample 623 
-"   in r16, %1\n   st z+, r16   \n" // sample 624 
-"   in r16, %1\n   st z+, r16   \n" // sample 625 
-"   in r16, %1\n   st z+, r16   \n" // sample 626 
-"   in r16, %1\n   st z+, r16   \n" // sample 627 
-"   in r16, %1\n   st z+, r16   \n" // sample 628 
-"   in r16, %1\n   st z+, r16   \n" // sample 629 
-"   in r16, %1\n   st z+, r16   \n" // sample 630 
-"   in r16, %1\n   st z+, r16   \n" // sample 631 
-"   in r16, %1\n   st z+, r16   \n" // sample 632 
-"   in r16, %1\n   st z+, r16   \n" // sample 633 
-"   in r16, %1\n   st z+, r16   \n" // sample 634 
-"   in r16, %1\n   st z+, r16   \n" // sample 635 
-"   in r16, %1\n   st z+, r16   \n" // sample 636 
-"   in r16, %1\n   st z+, r16   \n" // sample 637 
-"   in r16, %1\n   st z+, r16   \n" // sample 638 
-"   in r16, %1\n   st z+, r16   \n" // sample 639 
-"   in r16, %1\n   st z+, r16   \n" // sample 640 